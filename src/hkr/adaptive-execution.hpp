@@ -0,0 +1,191 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+
+namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
+
+    enum class resilience_strategy
+    {
+        replay,
+        hedged_replicate,
+        replicate
+    };
+
+    // Validator counting validations and failed validations. The counts live
+    // in the memory space of the kernels running the validator.
+    template <typename Pred, typename MemorySpace>
+    struct counting_validator
+    {
+        Pred pred_;
+
+        // Number of validations and of failed validations
+        Kokkos::View<std::uint64_t*, MemorySpace> counts_;
+
+        template <typename T>
+        KOKKOS_INLINE_FUNCTION bool operator()(T const& res) const
+        {
+            bool valid = pred_(res);
+
+            Kokkos::atomic_add(&counts_[0], std::uint64_t(1));
+            if (!valid)
+                Kokkos::atomic_add(&counts_[1], std::uint64_t(1));
+
+            return valid;
+        }
+    };
+
+    // Number of worker threads of the calling thread's pool, or of the
+    // default pool, which are currently idle
+    inline std::size_t idle_worker_count()
+    {
+        hpx::threads::thread_pool_base* pool = hpx::this_thread::get_pool();
+        if (pool == nullptr)
+            pool = &hpx::resource::get_thread_pool(0);
+
+        std::int64_t idle = pool->get_idle_core_count();
+
+        return idle > 0 ? static_cast<std::size_t>(idle) : 0;
+    }
+
+    // Copy the validation counts of a counting_validator to the host. Counts
+    // in memory accessible from the host are read directly. Counts in device
+    // memory are copied on the given instance every sample_interval tasks
+    // only, so that tasks don't wait for the device. The counts are left
+    // untouched if they were not read.
+    template <typename ExecutionSpace, typename MemorySpace>
+    void read_validation_counts(ExecutionSpace const& inst,
+        Kokkos::View<std::uint64_t*, MemorySpace> const& counts,
+        std::size_t task, std::uint64_t& validations, std::uint64_t& failures)
+    {
+        constexpr std::size_t sample_interval = 16;
+
+        if constexpr (Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                          MemorySpace>::accessible)
+        {
+            validations =
+                Kokkos::atomic_fetch_add(&counts[0], std::uint64_t(0));
+            failures = Kokkos::atomic_fetch_add(&counts[1], std::uint64_t(0));
+        }
+        else
+        {
+            if (task % sample_interval != 0)
+                return;
+
+            auto host_counts = Kokkos::create_mirror_view(counts);
+            Kokkos::deep_copy(inst, host_counts, counts);
+            inst.fence();
+
+            validations = host_counts[0];
+            failures = host_counts[1];
+        }
+    }
+
+    // Running estimates of the failure rate of a single attempt and of the
+    // duration of a single attempt
+    class adaptive_statistics
+    {
+    public:
+        // Weight of the latest observation in the moving averages
+        static constexpr double weight = 0.125;
+
+        // Index of the next completed task
+        std::size_t next_task()
+        {
+            return tasks_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Counts which are not newer than the previous ones are ignored
+        void update(std::uint64_t validations, std::uint64_t failures,
+            resilience_strategy strategy,
+            std::chrono::steady_clock::duration elapsed)
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+
+            if (validations > validations_)
+            {
+                double rate = double(failures - failures_) /
+                    double(validations - validations_);
+                failure_rate_ = has_samples_ ?
+                    (1.0 - weight) * failure_rate_ + weight * rate :
+                    rate;
+
+                validations_ = validations;
+                failures_ = failures;
+            }
+
+            // Replayed attempts run one after another
+            double duration =
+                std::chrono::duration<double>(elapsed).count();
+            if (strategy == resilience_strategy::replay)
+                duration *= 1.0 - failure_rate_;
+
+            duration_ = has_samples_ ?
+                (1.0 - weight) * duration_ + weight * duration :
+                duration;
+            has_samples_ = true;
+        }
+
+        // Strategy with the smallest expected completion time for a task
+        // with n attempts given the number of idle workers. Ties go to the
+        // strategy launching fewer copies.
+        resilience_strategy choose(std::size_t n, std::size_t idle) const
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+
+            if (!has_samples_ || n < 2)
+                return resilience_strategy::replay;
+
+            double p = failure_rate_;
+            double d = duration_;
+
+            double t_replay = p < 1.0 ?
+                d / (1.0 - p) :
+                std::numeric_limits<double>::infinity();
+
+            // Hedged copies have to wait for a worker if none is idle
+            double t_hedged = idle == 0 ? t_replay : d * (1.0 + p);
+
+            // Copies beyond the idle workers run one after another
+            double t_replicate = d * std::ceil(double(n) / double(idle + 1));
+
+            resilience_strategy strategy = resilience_strategy::replay;
+            double best = t_replay;
+
+            if (t_hedged < best)
+            {
+                strategy = resilience_strategy::hedged_replicate;
+                best = t_hedged;
+            }
+
+            if (t_replicate < best)
+                strategy = resilience_strategy::replicate;
+
+            return strategy;
+        }
+
+    private:
+        mutable std::mutex mtx_;
+        std::atomic<std::size_t> tasks_{0};
+
+        bool has_samples_ = false;
+        double failure_rate_ = 0.0;
+        double duration_ = 0.0;
+
+        // Counts seen by the previous update
+        std::uint64_t validations_ = 0;
+        std::uint64_t failures_ = 0;
+    };
+
+}}}}    // namespace hpx::kokkos::resiliency::detail
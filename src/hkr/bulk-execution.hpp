@@ -0,0 +1,485 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/kokkos.hpp>
+
+#include <hkr/performance-counters.hpp>
+#include <hkr/result-slot.hpp>
+#include <hkr/util.hpp>
+
+#include <hpx/future.hpp>
+#include <hpx/tuple.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
+
+    // Invoke f with an index or shape element prepended to the packed
+    // arguments
+    template <typename R, typename F, typename Elem, typename Tuple,
+        std::size_t... Is>
+    KOKKOS_INLINE_FUNCTION R invoke_indexed_r(hpx::util::index_pack<Is...>,
+        F const& f, Elem&& elem, Tuple const& t)
+    {
+        return f(std::forward<Elem>(elem), hpx::get<Is>(t)...);
+    }
+
+    // Fused kernels run over the shape times the replica count, which may
+    // exceed the range of int
+    template <typename ExecutionSpace>
+    using bulk_policy =
+        Kokkos::RangePolicy<ExecutionSpace, Kokkos::IndexType<std::int64_t>>;
+
+    // Host side outcome of a fused bulk launch
+    template <typename Result>
+    struct bulk_outcome
+    {
+        Kokkos::View<Result*, Kokkos::DefaultHostExecutionSpace> result;
+        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> failed;
+
+        // Aggregated failure report, empty if every element succeeded
+        std::exception_ptr error;
+    };
+
+    template <>
+    struct bulk_outcome<void>
+    {
+        // Empty if no element can fail
+        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> failed;
+        std::exception_ptr error;
+    };
+
+    inline std::size_t count_failures(
+        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> failed)
+    {
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i != failed.extent(0); ++i)
+        {
+            if (failed[i])
+                ++failures;
+        }
+
+        return failures;
+    }
+
+    inline std::exception_ptr make_bulk_exception(char const* what,
+        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> failed)
+    {
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i != failed.extent(0); ++i)
+        {
+            if (failed[i])
+                indices.push_back(i);
+        }
+
+        if (indices.empty())
+            return std::exception_ptr();
+
+        std::string msg = std::string(what) + " occured for " +
+            std::to_string(indices.size()) + " out of " +
+            std::to_string(failed.extent(0)) + " elements.";
+
+        return std::make_exception_ptr(
+            bulk_resiliency_exception(std::move(msg), std::move(indices)));
+    }
+
+    // Work items without a result can't fail on device execution spaces,
+    // which don't support exceptions. Every element runs exactly once in a
+    // single kernel, errors of the kernel itself are reported through its
+    // future.
+    template <typename ExecutionSpace, typename F, typename S, typename Tuple>
+    hpx::shared_future<bulk_outcome<void>> bulk_run_void(char const* label,
+        ExecutionSpace const& inst, F const& f, S const& s, Tuple const& tuple)
+    {
+        using index_pack_type =
+            typename hpx::util::detail::fused_index_pack<Tuple>::type;
+
+        std::size_t size = hpx::util::size(s);
+        auto b = hpx::util::begin(s);
+
+        hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(label,
+            bulk_policy<ExecutionSpace>(inst, 0, size),
+            KOKKOS_LAMBDA(std::int64_t i) {
+                invoke_indexed_r<void>(index_pack_type{}, f, *(b + i), tuple);
+            });
+
+        return fut.then(
+            hpx::launch::sync, [size](hpx::shared_future<void>&& f) {
+                // Throw any error reported by the kernel
+                f.get();
+
+                record_tasks(size, size, 0);
+
+                return bulk_outcome<void>{
+                    Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>(),
+                    std::exception_ptr()};
+            });
+    }
+
+    // Replay every work item without a result until it completes without
+    // throwing, at most n times, within a single kernel. Only kernels on
+    // host execution spaces can report errors, on devices every element
+    // runs once.
+    template <typename ExecutionSpace, typename F, typename S, typename Tuple>
+    hpx::shared_future<bulk_outcome<void>> bulk_replay_void(
+        ExecutionSpace const& inst, std::size_t n, F const& f, S const& s,
+        Tuple const& tuple)
+    {
+        if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                          ExecutionSpace>::value)
+        {
+            return bulk_run_void("bulk_replay_void", inst, f, s, tuple);
+        }
+        else
+        {
+            using index_pack_type =
+                typename hpx::util::detail::fused_index_pack<Tuple>::type;
+
+            std::size_t size = hpx::util::size(s);
+            auto b = hpx::util::begin(s);
+
+            Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> failed(
+                "bulk_replay_failed", size);
+            auto replays = std::make_shared<std::atomic<std::size_t>>(0);
+
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "bulk_replay_void",
+                bulk_policy<ExecutionSpace>(inst, 0, size),
+                [=](std::int64_t i) {
+                    for (std::size_t j = 0u; j < n; ++j)
+                    {
+                        try
+                        {
+                            invoke_indexed_r<void>(
+                                index_pack_type{}, f, *(b + i), tuple);
+
+                            *replays += j;
+                            return;
+                        }
+                        catch (...)
+                        {
+                        }
+                    }
+
+                    failed[i] = true;
+                    *replays += n - 1;
+                });
+
+            return fut.then(hpx::launch::sync,
+                [failed, replays](hpx::shared_future<void>&& f) {
+                    // Throw any error reported by the kernel
+                    f.get();
+
+                    bulk_outcome<void> outcome{failed,
+                        make_bulk_exception("Replay Exception", failed)};
+
+                    std::size_t size = failed.extent(0);
+                    record_tasks(size, size + *replays, count_failures(failed));
+
+                    return outcome;
+                });
+        }
+    }
+
+    // Replicate every work item without a result n times within a single
+    // kernel. An element succeeds once one of its replicas completes
+    // without throwing, later replicas of that element are skipped. On
+    // devices the first replica can't fail, so every element runs once.
+    template <typename ExecutionSpace, typename F, typename S, typename Tuple>
+    hpx::shared_future<bulk_outcome<void>> bulk_replicate_void(
+        ExecutionSpace const& inst, std::size_t n, F const& f, S const& s,
+        Tuple const& tuple)
+    {
+        if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                          ExecutionSpace>::value)
+        {
+            return bulk_run_void("bulk_replicate_void", inst, f, s, tuple);
+        }
+        else
+        {
+            using index_pack_type =
+                typename hpx::util::detail::fused_index_pack<Tuple>::type;
+
+            std::size_t size = hpx::util::size(s);
+            auto b = hpx::util::begin(s);
+
+            Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> done(
+                "bulk_replicate_done", size);
+            auto replicas = std::make_shared<std::atomic<std::size_t>>(0);
+
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "bulk_replicate_void",
+                bulk_policy<ExecutionSpace>(inst, 0, size * n),
+                [=](std::int64_t idx) {
+                    std::size_t i = static_cast<std::size_t>(idx) % size;
+
+                    bool ran = run_replica(
+                        [&] { return Kokkos::volatile_load(&done[i]); },
+                        [&] {
+                            try
+                            {
+                                invoke_indexed_r<void>(
+                                    index_pack_type{}, f, *(b + i), tuple);
+                                return true;
+                            }
+                            catch (...)
+                            {
+                                return false;
+                            }
+                        },
+                        [&](bool completed) {
+                            if (completed)
+                                Kokkos::atomic_exchange(&done[i], true);
+                        });
+
+                    if (ran)
+                        ++*replicas;
+                });
+
+            return fut.then(hpx::launch::sync,
+                [done, replicas](hpx::shared_future<void>&& f) {
+                    // Throw any error reported by the kernel
+                    f.get();
+
+                    bulk_outcome<void> outcome{
+                        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>(
+                            "bulk_host_failed", done.extent(0)),
+                        std::exception_ptr()};
+
+                    // Elements without a completed replica have failed
+                    for (std::size_t i = 0; i != done.extent(0); ++i)
+                        outcome.failed[i] = !done[i];
+
+                    outcome.error = make_bulk_exception(
+                        "Replicate Exception", outcome.failed);
+
+                    std::size_t size = done.extent(0);
+                    record_tasks(
+                        size, *replicas, count_failures(outcome.failed));
+
+                    return outcome;
+                });
+        }
+    }
+
+    // Replay every element of the shape independently within a single kernel
+    template <typename Result, typename ExecutionSpace, typename Pred,
+        typename F, typename S, typename Tuple>
+    hpx::shared_future<bulk_outcome<Result>> bulk_replay(
+        ExecutionSpace const& inst, std::size_t n, Pred const& pred,
+        F const& f, S const& s, Tuple const& tuple)
+    {
+        using index_pack_type =
+            typename hpx::util::detail::fused_index_pack<Tuple>::type;
+
+        auto size = hpx::util::size(s);
+        auto b = hpx::util::begin(s);
+
+        Kokkos::View<Result*, ExecutionSpace> exec_result(
+            "bulk_replay_result", size);
+        Kokkos::View<bool*, ExecutionSpace> exec_failed(
+            "bulk_replay_failed", size);
+        Kokkos::View<std::size_t*, ExecutionSpace> exec_replays(
+            "bulk_replay_replays", 1);
+
+        hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+            "bulk_replay_validate",
+            bulk_policy<ExecutionSpace>(inst, 0, size),
+            KOKKOS_LAMBDA(std::int64_t i) {
+                for (std::size_t j = 0u; j < n; ++j)
+                {
+                    Result res = invoke_indexed_r<Result>(
+                        index_pack_type{}, f, *(b + i), tuple);
+
+                    if (pred(res))
+                    {
+                        exec_result[i] = std::move(res);
+
+                        if (j != 0)
+                            Kokkos::atomic_add(&exec_replays[0], j);
+                        return;
+                    }
+                }
+
+                exec_failed[i] = true;
+                Kokkos::atomic_add(&exec_replays[0], n - 1);
+            });
+
+        return fut.then(hpx::launch::sync,
+            [exec_result, exec_failed, exec_replays](
+                hpx::shared_future<void>&& f) {
+                // Throw any error reported by the kernel
+                f.get();
+
+                bulk_outcome<Result> outcome{
+                    Kokkos::View<Result*, Kokkos::DefaultHostExecutionSpace>(
+                        "bulk_host_result", exec_result.extent(0)),
+                    Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>(
+                        "bulk_host_failed", exec_failed.extent(0)),
+                    std::exception_ptr()};
+
+                Kokkos::View<std::size_t*, Kokkos::DefaultHostExecutionSpace>
+                    host_replays("bulk_host_replays", 1);
+
+                Kokkos::deep_copy(outcome.result, exec_result);
+                Kokkos::deep_copy(outcome.failed, exec_failed);
+                Kokkos::deep_copy(host_replays, exec_replays);
+
+                outcome.error =
+                    make_bulk_exception("Replay Exception", outcome.failed);
+
+                std::size_t size = outcome.failed.extent(0);
+                record_tasks(size, size + host_replays[0],
+                    count_failures(outcome.failed));
+
+                return outcome;
+            });
+    }
+
+    // Replicate every element of the shape n times within a single kernel.
+    // Iterations are ordered replica by replica so that later replicas of an
+    // element which already has a valid result are skipped.
+    template <typename Result, typename ExecutionSpace, typename Pred,
+        typename F, typename S, typename Tuple>
+    hpx::shared_future<bulk_outcome<Result>> bulk_replicate(
+        ExecutionSpace const& inst, std::size_t n, Pred const& pred,
+        F const& f, S const& s, Tuple const& tuple)
+    {
+        using index_pack_type =
+            typename hpx::util::detail::fused_index_pack<Tuple>::type;
+
+        std::size_t size = hpx::util::size(s);
+        auto b = hpx::util::begin(s);
+
+        // Every element's result is stored with publish_once
+        Kokkos::View<Result*, ExecutionSpace> exec_result(
+            "bulk_replicate_result", size);
+        Kokkos::View<int*, ExecutionSpace> exec_state(
+            "bulk_replicate_state", size);
+        Kokkos::View<std::size_t*, ExecutionSpace> exec_replicas(
+            "bulk_replicate_replicas", 1);
+
+        hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+            "bulk_replicate_validate",
+            bulk_policy<ExecutionSpace>(inst, 0, size * n),
+            KOKKOS_LAMBDA(std::int64_t idx) {
+                std::size_t i = static_cast<std::size_t>(idx) % size;
+
+                bool ran = run_replica(
+                    [&] { return result_taken(&exec_state[i]); },
+                    [&] {
+                        return invoke_indexed_r<Result>(
+                            index_pack_type{}, f, *(b + i), tuple);
+                    },
+                    [&](Result&& res) {
+                        if (pred(res))
+                            publish_once(&exec_state[i],
+                                [&] { exec_result[i] = std::move(res); });
+                    });
+
+                if (ran)
+                    Kokkos::atomic_add(&exec_replicas[0], std::size_t(1));
+            });
+
+        return fut.then(hpx::launch::sync,
+            [exec_result, exec_state, exec_replicas](
+                hpx::shared_future<void>&& f) {
+                // Throw any error reported by the kernel
+                f.get();
+
+                bulk_outcome<Result> outcome{
+                    Kokkos::View<Result*, Kokkos::DefaultHostExecutionSpace>(
+                        "bulk_host_result", exec_result.extent(0)),
+                    Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>(
+                        "bulk_host_failed", exec_state.extent(0)),
+                    std::exception_ptr()};
+
+                auto host_state = Kokkos::create_mirror_view(exec_state);
+                Kokkos::View<std::size_t*, Kokkos::DefaultHostExecutionSpace>
+                    host_replicas("bulk_host_replicas", 1);
+
+                Kokkos::deep_copy(outcome.result, exec_result);
+                Kokkos::deep_copy(host_state, exec_state);
+                Kokkos::deep_copy(host_replicas, exec_replicas);
+
+                // Elements without a published result have failed
+                for (std::size_t i = 0; i != outcome.failed.extent(0); ++i)
+                    outcome.failed[i] = host_state[i] != result_published;
+
+                outcome.error =
+                    make_bulk_exception("Replicate Exception", outcome.failed);
+
+                std::size_t size = outcome.failed.extent(0);
+                record_tasks(
+                    size, host_replicas[0], count_failures(outcome.failed));
+
+                return outcome;
+            });
+    }
+
+    // Derive one future per element from the outcome of a fused launch.
+    // Elements without a result share a single future, which fails with the
+    // aggregated error if any element failed. Elements with a result get a
+    // promise each, all of them are fulfilled from a single continuation.
+    template <typename Result>
+    std::vector<hpx::shared_future<Result>> split_bulk_outcome(
+        hpx::shared_future<bulk_outcome<Result>> const& fut, std::size_t size)
+    {
+        if constexpr (std::is_void<Result>::value)
+        {
+            hpx::shared_future<void> all = fut.then(hpx::launch::sync,
+                [](hpx::shared_future<bulk_outcome<void>> const& f) {
+                    auto const& outcome = f.get();
+
+                    if (outcome.error)
+                        std::rethrow_exception(outcome.error);
+                });
+
+            return std::vector<hpx::shared_future<void>>(size, all);
+        }
+        else
+        {
+            using promises_t = std::vector<hpx::lcos::local::promise<Result>>;
+
+            auto promises = std::make_shared<promises_t>(size);
+
+            std::vector<hpx::shared_future<Result>> result;
+            result.reserve(size);
+            for (auto& p : *promises)
+                result.push_back(p.get_future());
+
+            fut.then(hpx::launch::sync,
+                [promises](hpx::shared_future<bulk_outcome<Result>> const& f) {
+                    promises_t& ps = *promises;
+
+                    if (f.has_exception())
+                    {
+                        for (auto& p : ps)
+                            p.set_exception(f.get_exception_ptr());
+                        return;
+                    }
+
+                    auto const& outcome = f.get();
+                    for (std::size_t i = 0; i != ps.size(); ++i)
+                    {
+                        if (outcome.failed[i])
+                            ps[i].set_exception(outcome.error);
+                        else
+                            ps[i].set_value(outcome.result[i]);
+                    }
+                });
+
+            return result;
+        }
+    }
+
+}}}}    // namespace hpx::kokkos::resiliency::detail
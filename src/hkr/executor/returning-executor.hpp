@@ -16,13 +16,19 @@
 #include <hpx/kokkos/kokkos_algorithms.hpp>
 #include <hpx/kokkos/make_instance.hpp>
 
+#include <hkr/result-slot.hpp>
+#include <hkr/traits.hpp>
+#include <hkr/util.hpp>
+
 #include <hpx/algorithm.hpp>
 #include <hpx/numeric.hpp>
 #include <hpx/tuple.hpp>
 
 #include <Kokkos_Core.hpp>
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace hpx { namespace kokkos {
 
@@ -74,29 +80,65 @@ namespace hpx { namespace kokkos {
 
             auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-            Kokkos::View<return_t*, ExecutionSpace> result("result", 1);
-            Kokkos::View<return_t*, Kokkos::DefaultHostExecutionSpace>
-                result_host("host_result", 1);
-
-            // Get a handle of future
-            hpx::shared_future<void> fut = parallel_for_async(
-                Kokkos::Experimental::require(
-                    Kokkos::RangePolicy<execution_space>(inst, 0, 1),
-                    Kokkos::Experimental::WorkItemProperty::HintLightWeight),
-                KOKKOS_LAMBDA(int) {
-                    result[0] = hpx::util::invoke_fused_r<return_t>(f, ts_pack);
-                });
-
-            // Attach a continuation and return result
-            return fut.then(
-                hpx::launch::sync, [=](hpx::shared_future<void>&& f) {
-                    // Throw any error reported by f
-                    f.get();
-
-                    // Deep copy it to the host version and return the result
-                    Kokkos::deep_copy(result_host, result);
-                    return result_host[0];
-                });
+            if constexpr (!hpx::kokkos::traits::is_device_execution_space<
+                              execution_space>::value)
+            {
+                // Host results are moved into the returned future once the
+                // kernel has completed
+                auto slot = std::make_shared<
+                    hpx::kokkos::resiliency::detail::host_result_slot<
+                        return_t>>();
+                hpx::future<return_t> result = slot->promise.get_future();
+
+                hpx::shared_future<void> fut = parallel_for_async(
+                    Kokkos::Experimental::require(
+                        Kokkos::RangePolicy<execution_space>(inst, 0, 1),
+                        Kokkos::Experimental::WorkItemProperty::
+                            HintLightWeight),
+                    KOKKOS_LAMBDA(int) {
+                        slot->publish(
+                            hpx::util::invoke_fused_r<return_t>(f, ts_pack));
+                    });
+
+                // Forward any error reported by f
+                fut.then(hpx::launch::sync,
+                    [slot](hpx::shared_future<void>&& f) {
+                        slot->complete(f,
+                            hpx::kokkos::resiliency::detail::
+                                resiliency_exception());
+                    });
+
+                return result;
+            }
+            else
+            {
+                Kokkos::View<return_t*, ExecutionSpace> result("result", 1);
+                Kokkos::View<return_t*, Kokkos::DefaultHostExecutionSpace>
+                    result_host("host_result", 1);
+
+                // Get a handle of future
+                hpx::shared_future<void> fut = parallel_for_async(
+                    Kokkos::Experimental::require(
+                        Kokkos::RangePolicy<execution_space>(inst, 0, 1),
+                        Kokkos::Experimental::WorkItemProperty::
+                            HintLightWeight),
+                    KOKKOS_LAMBDA(int) {
+                        result[0] =
+                            hpx::util::invoke_fused_r<return_t>(f, ts_pack);
+                    });
+
+                // Attach a continuation and return result
+                return fut.then(
+                    hpx::launch::sync, [=](hpx::shared_future<void>&& f) {
+                        // Throw any error reported by f
+                        f.get();
+
+                        // Deep copy it to the host version and move the
+                        // result out
+                        Kokkos::deep_copy(result_host, result);
+                        return std::move(result_host[0]);
+                    });
+            }
         }
 
         template <typename F, typename S, typename... Ts>
@@ -125,10 +167,18 @@ namespace hpx { namespace kokkos {
             return result;
         }
 
+        // Honor the chunk size requested by the execution parameters, run
+        // the whole range as a single chunk otherwise
         template <typename Parameters, typename F>
-        constexpr std::size_t get_chunk_size(Parameters&& params, F&& f,
+        std::size_t get_chunk_size(Parameters&& params, F&& f,
             std::size_t cores, std::size_t count) const
         {
+            std::size_t chunk_size =
+                hpx::kokkos::resiliency::detail::requested_chunk_size(
+                    0, params, *this, f, cores, count);
+            if (chunk_size != 0)
+                return chunk_size;
+
             return std::size_t(-1);
         }
 
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/kokkos.hpp>
+
+#include <hkr/performance-counters.hpp>
+#include <hkr/util.hpp>
+
+#include <hpx/future.hpp>
+#include <hpx/tuple.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
+
+    // Latencies of the most recently completed tasks
+    class latency_tracker
+    {
+    public:
+        using duration = std::chrono::steady_clock::duration;
+
+        static constexpr std::size_t num_samples = 64;
+
+        void record(duration latency)
+        {
+            std::lock_guard<std::mutex> l(mtx_);
+            samples_[next_++ % num_samples] = latency;
+        }
+
+        // Latency within which the fraction p of the recent tasks completed,
+        // duration::max() as long as no task has completed
+        duration percentile(double p) const
+        {
+            std::vector<duration> samples;
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                samples.assign(samples_.begin(),
+                    samples_.begin() + (std::min)(next_, num_samples));
+            }
+
+            if (samples.empty())
+                return duration::max();
+
+            auto nth = samples.begin() +
+                static_cast<std::size_t>(p * (samples.size() - 1));
+            std::nth_element(samples.begin(), nth, samples.end());
+
+            return *nth;
+        }
+
+    private:
+        mutable std::mutex mtx_;
+        std::array<duration, num_samples> samples_;
+        std::size_t next_ = 0;
+    };
+
+    // Replicates a task lazily. A single copy is launched first, the
+    // remaining copies follow once the threshold has elapsed without a valid
+    // result. A copy failing validation while no other copy is running is
+    // replaced right away. The first valid result wins.
+    template <typename Executor, typename Result, typename Pred, typename F,
+        typename Tuple>
+    struct hedged_replicate_helper
+      : std::enable_shared_from_this<
+            hedged_replicate_helper<Executor, Result, Pred, F, Tuple>>
+    {
+        template <typename Pred_, typename F_, typename Tuple_>
+        hedged_replicate_helper(std::size_t n, Pred_&& pred, F_&& f,
+            Tuple_&& tuple, std::shared_ptr<latency_tracker> tracker)
+          : n_(n)
+          , pred_(std::forward<Pred_>(pred))
+          , f_(std::forward<F_>(f))
+          , t_(std::forward<Tuple_>(tuple))
+          , tracker_(std::move(tracker))
+        {
+        }
+
+        hpx::future<Result> call(latency_tracker::duration threshold)
+        {
+            hpx::future<Result> result = promise_.get_future();
+
+            start_ = std::chrono::steady_clock::now();
+            launched_ = 1;
+            launch();
+
+            if (n_ > 1 && threshold != latency_tracker::duration::max())
+            {
+                hpx::make_ready_future_after(threshold).then(
+                    hpx::launch::sync,
+                    [this_ = this->shared_from_this()](
+                        hpx::future<void>&&) { this_->hedge(); });
+            }
+
+            return result;
+        }
+
+        // Launch all remaining copies if no valid result arrived in time
+        void hedge()
+        {
+            std::size_t count = 0;
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                if (done_)
+                    return;
+
+                count = n_ - launched_;
+                launched_ = n_;
+            }
+
+            for (std::size_t i = 0u; i != count; ++i)
+                launch();
+        }
+
+        // Every copy runs on its own independent instance
+        void launch()
+        {
+            auto pred = pred_;
+            auto f = f_;
+            auto tuple = t_;
+
+            hpx::async(Executor{hpx::kokkos::execution_space_mode::independent},
+                KOKKOS_LAMBDA() {
+                    Result res = hpx::util::invoke_fused_r<Result>(f, tuple);
+
+                    bool result = pred(res);
+
+                    return hpx::make_tuple(result, std::move(res));
+                })
+                .then(hpx::launch::sync,
+                    [this_ = this->shared_from_this()](
+                        hpx::future<hpx::tuple<bool, Result>>&& f) {
+                        this_->on_completed(std::move(f));
+                    });
+        }
+
+        void on_completed(hpx::future<hpx::tuple<bool, Result>>&& f)
+        {
+            // Copies reporting an error count as failed copies
+            if (!f.has_exception())
+            {
+                auto&& result = f.get();
+                if (hpx::get<0>(result))
+                {
+                    std::size_t attempts = 0;
+                    {
+                        std::lock_guard<std::mutex> l(mtx_);
+                        ++finished_;
+                        if (done_)
+                            return;
+
+                        done_ = true;
+                        attempts = launched_;
+                    }
+
+                    tracker_->record(std::chrono::steady_clock::now() - start_);
+                    record_task(attempts, false);
+
+                    promise_.set_value(hpx::get<1>(std::move(result)));
+                    return;
+                }
+            }
+
+            bool relaunch = false;
+            bool failed = false;
+            {
+                std::lock_guard<std::mutex> l(mtx_);
+                ++finished_;
+                if (done_)
+                    return;
+
+                if (finished_ == n_)
+                {
+                    done_ = true;
+                    failed = true;
+                }
+                else if (finished_ == launched_)
+                {
+                    ++launched_;
+                    relaunch = true;
+                }
+            }
+
+            if (relaunch)
+            {
+                launch();
+            }
+            else if (failed)
+            {
+                record_task(n_, true);
+
+                promise_.set_exception(std::make_exception_ptr(
+                    resiliency_exception("Replicate Exception occured.")));
+            }
+        }
+
+        std::size_t n_;
+        Pred pred_;
+        F f_;
+        Tuple t_;
+        std::shared_ptr<latency_tracker> tracker_;
+
+        hpx::lcos::local::promise<Result> promise_;
+        std::chrono::steady_clock::time_point start_;
+
+        std::mutex mtx_;
+        std::size_t launched_ = 0;
+        std::size_t finished_ = 0;
+        bool done_ = false;
+    };
+
+}}}}    // namespace hpx::kokkos::resiliency::detail
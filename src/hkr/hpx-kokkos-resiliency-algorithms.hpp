@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/kokkos.hpp>
+
+#include <hkr/hpx-kokkos-resiliency-executor.hpp>
+
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/numeric.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace kokkos { namespace resiliency {
+
+    namespace detail {
+
+        template <typename Executor>
+        struct is_resilient_executor : std::false_type
+        {
+        };
+
+        template <typename BaseExecutor, typename Validator>
+        struct is_resilient_executor<
+            replay_executor<BaseExecutor, Validator>> : std::true_type
+        {
+        };
+
+        template <typename BaseExecutor, typename Validator>
+        struct is_resilient_executor<
+            replicate_executor<BaseExecutor, Validator>> : std::true_type
+        {
+        };
+
+        template <typename ExPolicy>
+        struct is_resilient_policy
+          : is_resilient_executor<typename std::decay<
+                typename std::decay<ExPolicy>::type::executor_type>::type>
+        {
+        };
+    }    // namespace detail
+
+    // transform_reduce on a policy bound to a resilient executor, e.g.
+    // hpx::transform_reduce(par.on(replay_exec), ...). The executor's
+    // validator is applied to the partial result of every chunk, so that a
+    // fault only causes its own chunk to be replayed or replicated. The
+    // partial results are combined with init once all chunks are valid.
+    // Chunks read the input through the host iterator, so only executors on
+    // host accessible execution spaces are supported.
+    template <typename ExPolicy, typename Iter, typename T, typename Reduce,
+        typename Convert,
+        HPX_CONCEPT_REQUIRES_(hpx::is_execution_policy<ExPolicy>::value&&
+                detail::is_resilient_policy<ExPolicy>::value&& std::is_base_of<
+                    std::random_access_iterator_tag,
+                    typename std::iterator_traits<Iter>::iterator_category>::
+                    value)>
+    typename hpx::parallel::util::detail::algorithm_result<ExPolicy, T>::type
+    tag_invoke(hpx::transform_reduce_t, ExPolicy&& policy, Iter first,
+        Iter last, T init, Reduce&& red_op, Convert&& conv_op)
+    {
+        using result = hpx::parallel::util::detail::algorithm_result<ExPolicy,
+            T>;
+
+        std::size_t count = std::distance(first, last);
+        if (count == 0)
+            return result::get(std::move(init));
+
+        auto exec = policy.executor();
+
+        using execution_space =
+            typename std::decay<decltype(exec)>::type::execution_space;
+        static_assert(Kokkos::SpaceAccessibility<execution_space,
+                          Kokkos::HostSpace>::accessible,
+            "resilient transform_reduce reads its input through host "
+            "iterators and requires a host accessible execution space");
+
+        auto red = red_op;
+        auto conv = conv_op;
+
+        std::size_t chunk_size = exec.get_chunk_size(policy.parameters(), conv,
+            hpx::get_os_thread_count(), count);
+
+        auto chunk_reduce = KOKKOS_LAMBDA(std::size_t start)
+        {
+            std::size_t end =
+                start + chunk_size < count ? start + chunk_size : count;
+
+            T partial = conv(first[start]);
+            for (std::size_t i = start + 1; i < end; ++i)
+                partial = red(std::move(partial), conv(first[i]));
+
+            return partial;
+        };
+
+        std::vector<std::size_t> shape;
+        shape.reserve((count + chunk_size - 1) / chunk_size);
+        for (std::size_t start = 0; start < count; start += chunk_size)
+            shape.push_back(start);
+
+        std::vector<hpx::shared_future<T>> partials =
+            exec.bulk_async_execute(chunk_reduce, shape);
+
+        // The partial results are combined in order on a single thread,
+        // failing chunks rethrow the aggregated resiliency exception. The
+        // executor creates at most a few chunks per core, so a reduction
+        // tree wouldn't pay off here.
+        auto combine = [init = std::move(init),
+                           red_op = std::forward<Reduce>(red_op)](
+                           hpx::future<std::vector<hpx::shared_future<T>>>&&
+                               f) mutable {
+            auto partials = f.get();
+
+            T value = std::move(init);
+            for (auto& partial : partials)
+                value = red_op(std::move(value), partial.get());
+
+            return value;
+        };
+
+        hpx::future<T> f = hpx::when_all(std::move(partials))
+                               .then(hpx::launch::sync, std::move(combine));
+
+        return result::get(std::move(f));
+    }
+
+}}}    // namespace hpx::kokkos::resiliency
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_CXX20_COROUTINES)
+
+#include <hkr/hpx-kokkos-resiliency-senders.hpp>
+
+#include <hpx/execution.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace kokkos { namespace resiliency {
+
+    namespace detail {
+
+        // Awaitable driving a resilient sender. The awaiting coroutine is
+        // suspended instead of blocking its worker. The sender completes on a
+        // new HPX thread once the Kokkos kernel has completed, so the
+        // coroutine is resumed inline from the receiver.
+        template <typename Sender, typename Result>
+        class resilient_awaitable
+        {
+            struct receiver
+            {
+                resilient_awaitable* self_;
+
+                friend void tag_invoke(
+                    hpx::execution::experimental::set_value_t, receiver&& r,
+                    Result&& value) noexcept
+                {
+                    r.self_->result_.emplace(std::move(value));
+                    r.self_->continuation_.resume();
+                }
+
+                friend void tag_invoke(
+                    hpx::execution::experimental::set_error_t, receiver&& r,
+                    std::exception_ptr ep) noexcept
+                {
+                    r.self_->error_ = std::move(ep);
+                    r.self_->continuation_.resume();
+                }
+
+                friend void tag_invoke(
+                    hpx::execution::experimental::set_done_t,
+                    receiver&&) noexcept
+                {
+                    // Resilient senders never complete with set_done
+                    std::terminate();
+                }
+            };
+
+            using operation_state_type =
+                decltype(hpx::execution::experimental::connect(
+                    std::declval<Sender>(), std::declval<receiver>()));
+
+            // Allows constructing the immovable operation state in place
+            struct connect_helper
+            {
+                Sender& sender_;
+                resilient_awaitable* self_;
+
+                operator operation_state_type() &&
+                {
+                    return hpx::execution::experimental::connect(
+                        std::move(sender_), receiver{self_});
+                }
+            };
+
+        public:
+            explicit resilient_awaitable(Sender&& sender)
+              : sender_(std::move(sender))
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> continuation)
+            {
+                continuation_ = continuation;
+
+                op_.emplace(connect_helper{sender_, this});
+                hpx::execution::experimental::start(*op_);
+            }
+
+            Result await_resume()
+            {
+                if (error_)
+                    std::rethrow_exception(error_);
+
+                return std::move(*result_);
+            }
+
+        private:
+            Sender sender_;
+            std::coroutine_handle<> continuation_;
+            std::optional<operation_state_type> op_;
+            std::optional<Result> result_;
+            std::exception_ptr error_;
+        };
+
+        template <typename Result, typename Sender>
+        resilient_awaitable<Sender, Result> make_resilient_awaitable(
+            Sender&& sender)
+        {
+            return resilient_awaitable<Sender, Result>(
+                std::forward<Sender>(sender));
+        }
+    }    // namespace detail
+
+    // co_await-able counterpart of async_replay_validate
+    template <typename Executor, typename Pred, typename F, typename... Ts>
+    decltype(auto) replay_validate_awaitable(Executor&& exec, std::size_t n,
+        Pred&& pred, F&& f, Ts&&... ts)
+    {
+        using result_t =
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type;
+
+        return detail::make_resilient_awaitable<result_t>(
+            replay_validate_sender(std::forward<Executor>(exec), n,
+                std::forward<Pred>(pred), std::forward<F>(f),
+                std::forward<Ts>(ts)...));
+    }
+
+    // co_await-able counterpart of async_replicate_validate
+    template <typename Executor, typename Pred, typename F, typename... Ts>
+    decltype(auto) replicate_validate_awaitable(Executor&& exec,
+        std::size_t n, Pred&& pred, F&& f, Ts&&... ts)
+    {
+        using result_t =
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type;
+
+        return detail::make_resilient_awaitable<result_t>(
+            replicate_validate_sender(std::forward<Executor>(exec), n,
+                std::forward<Pred>(pred), std::forward<F>(f),
+                std::forward<Ts>(ts)...));
+    }
+
+}}}    // namespace hpx::kokkos::resiliency
+
+#endif
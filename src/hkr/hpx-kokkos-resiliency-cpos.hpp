@@ -39,4 +39,34 @@ namespace hpx { namespace kokkos { namespace resiliency {
     {
     } dataflow_replicate_validate{};
 
+    HPX_INLINE_CONSTEXPR_VARIABLE struct async_replicate_validate_placed_t final
+      : hpx::functional::tag<async_replicate_validate_placed_t>
+    {
+    } async_replicate_validate_placed{};
+
+    HPX_INLINE_CONSTEXPR_VARIABLE struct async_replay_validate_n_t final
+      : hpx::functional::tag<async_replay_validate_n_t>
+    {
+    } async_replay_validate_n{};
+
+    HPX_INLINE_CONSTEXPR_VARIABLE struct async_replay_validate_for_t final
+      : hpx::functional::tag<async_replay_validate_for_t>
+    {
+    } async_replay_validate_for{};
+
+    HPX_INLINE_CONSTEXPR_VARIABLE struct async_replay_validate_split_t final
+      : hpx::functional::tag<async_replay_validate_split_t>
+    {
+    } async_replay_validate_split{};
+
+    HPX_INLINE_CONSTEXPR_VARIABLE struct replay_validate_sender_t final
+      : hpx::functional::tag<replay_validate_sender_t>
+    {
+    } replay_validate_sender{};
+
+    HPX_INLINE_CONSTEXPR_VARIABLE struct replicate_validate_sender_t final
+      : hpx::functional::tag<replicate_validate_sender_t>
+    {
+    } replicate_validate_sender{};
+
 }}}    // namespace hpx::kokkos::resiliency
\ No newline at end of file
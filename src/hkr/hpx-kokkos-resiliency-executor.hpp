@@ -2,12 +2,25 @@
 
 #include <hpx/resiliency/resiliency.hpp>
 
+#include <hpx/future.hpp>
 #include <hpx/kokkos.hpp>
 
+#include <hkr/adaptive-execution.hpp>
+#include <hkr/bulk-execution.hpp>
+#include <hkr/hedged-execution.hpp>
 #include <hkr/hpx-kokkos-resiliency-cpos.hpp>
+#include <hkr/performance-counters.hpp>
+#include <hkr/then-execution.hpp>
 #include <hkr/traits.hpp>
+#include <hkr/util.hpp>
 
-#include <boost/type_index.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace hpx { namespace kokkos { namespace resiliency {
 
@@ -22,6 +35,7 @@ namespace hpx { namespace kokkos { namespace resiliency {
         using execution_parameters_type =
             typename hpx::parallel::execution::extract_executor_parameters<
                 BaseExecutor>::type;
+        using parameters_type = execution_parameters_type;
         using execution_space = typename BaseExecutor::execution_space;
 
         template <typename Result>
@@ -39,7 +53,7 @@ namespace hpx { namespace kokkos { namespace resiliency {
 
         bool operator==(replay_executor const& rhs) const noexcept
         {
-            return exec_ = rhs.exec_;
+            return &exec_ == &rhs.exec_;
         }
 
         bool operator!=(replay_executor const& rhs) const noexcept
@@ -64,32 +78,102 @@ namespace hpx { namespace kokkos { namespace resiliency {
                 std::forward<F>(f), std::forward<Ts>(ts)...);
         }
 
+        // Host execution spaces replay inline on the calling thread, device
+        // execution spaces wait for the asynchronous replay
+        template <typename F, typename... Ts>
+        decltype(auto) sync_execute(F&& f, Ts&&... ts)
+        {
+            if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                              execution_space>::value)
+            {
+                return async_execute(
+                    std::forward<F>(f), std::forward<Ts>(ts)...)
+                    .get();
+            }
+            else
+            {
+                using result_t =
+                    typename hpx::util::detail::invoke_deferred_result<F,
+                        Ts...>::type;
+
+                // Ensure the value of n is greater than 0
+                HPX_ASSERT(replay_count_ > 0);
+
+                for (std::size_t i = 0u; i < replay_count_; ++i)
+                {
+                    result_t res = HPX_INVOKE(f, ts...);
+
+                    auto start = std::chrono::steady_clock::now();
+                    bool valid = validator_(res);
+                    detail::record_validator_time(
+                        std::chrono::steady_clock::now() - start);
+
+                    if (valid)
+                    {
+                        detail::record_task(i + 1, false);
+                        return res;
+                    }
+                }
+
+                detail::record_task(replay_count_, true);
+
+                throw detail::resiliency_exception("Replay Exception occured.");
+            }
+        }
+
+        // All elements of the shape are replayed within a single kernel. The
+        // futures of failing elements report every failing element at once.
         template <typename F, typename S, typename... Ts>
         decltype(auto) bulk_async_execute(F&& f, S const& s, Ts&&... ts)
         {
             HPX_KOKKOS_DETAIL_LOG("replay_bulk_async_execute");
 
-            auto b = hpx::util::begin(s);
-
             using result_t = typename hpx::util::detail::invoke_deferred_result<
-                decltype(f.f_.f_), decltype(hpx::get<0>(*b)), Ts...>::type;
+                F, decltype(*hpx::util::begin(s)), Ts...>::type;
 
-            std::cout << boost::typeindex::type_id<result_t>().pretty_name()
-                      << std::endl;
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-            std::vector<hpx::future<void>> result;
-            for (auto const& elem : s)
+            // Work items without a result, e.g. the chunks of a for_loop,
+            // are valid once they complete without throwing
+            if constexpr (std::is_void<result_t>::value)
             {
-                // result.push_back(hpx::async([&]() {
-                //     async_execute(
-                //         std::forward<F>(f), elem, std::forward<Ts>(ts)...)
-                //         .get();
-                // }));
-
-                result.push_back(hpx::make_ready_future());
+                return detail::split_bulk_outcome(
+                    detail::bulk_replay_void(
+                        exec_.instance(), replay_count_, f, s, ts_pack),
+                    hpx::util::size(s));
+            }
+            else
+            {
+                return detail::split_bulk_outcome(
+                    detail::bulk_replay<result_t>(exec_.instance(),
+                        replay_count_, validator_, f, s, ts_pack),
+                    hpx::util::size(s));
             }
+        }
+
+        template <typename F, typename Future, typename... Ts>
+        decltype(auto) then_execute(F&& f, Future&& predecessor, Ts&&... ts)
+        {
+            return detail::then_execute(*this, std::forward<F>(f),
+                std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+        }
 
-            return result;
+        template <typename F, typename S, typename Future, typename... Ts>
+        decltype(auto) bulk_then_execute(
+            F&& f, S const& s, Future&& predecessor, Ts&&... ts)
+        {
+            return detail::bulk_then_execute(*this, std::forward<F>(f), s,
+                std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+        }
+
+        // Every chunk is a single work item of the bulk kernel, a failing
+        // chunk is replayed as a whole
+        template <typename Parameters, typename F>
+        std::size_t get_chunk_size(Parameters&& params, F&& f,
+            std::size_t cores, std::size_t count) const
+        {
+            return detail::resilient_chunk_size(
+                params, *this, f, cores, count, num_spread, num_task);
         }
 
     private:
@@ -109,6 +193,7 @@ namespace hpx { namespace kokkos { namespace resiliency {
         using execution_parameters_type =
             typename hpx::parallel::execution::extract_executor_parameters<
                 BaseExecutor>::type;
+        using parameters_type = execution_parameters_type;
         using execution_space = typename BaseExecutor::execution_space;
 
         template <typename Result>
@@ -126,7 +211,7 @@ namespace hpx { namespace kokkos { namespace resiliency {
 
         bool operator==(replicate_executor const& rhs) const noexcept
         {
-            return exec_ = rhs.exec_;
+            return &exec_ == &rhs.exec_;
         }
 
         bool operator!=(replicate_executor const& rhs) const noexcept
@@ -151,24 +236,59 @@ namespace hpx { namespace kokkos { namespace resiliency {
                 std::forward<F>(f), std::forward<Ts>(ts)...);
         }
 
+        // All replicas of all elements of the shape run within a single
+        // kernel, results are combined per element in place
         template <typename F, typename S, typename... Ts>
         decltype(auto) bulk_async_execute(F&& f, S const& s, Ts&&... ts)
         {
             HPX_KOKKOS_DETAIL_LOG("replicate_bulk_async_execute");
 
-            auto b = hpx::util::begin(s);
+            using result_t = typename hpx::util::detail::invoke_deferred_result<
+                F, decltype(*hpx::util::begin(s)), Ts...>::type;
 
-            using result_t =
-                typename hpx::util::invoke_result<F, decltype(*b), Ts...>::type;
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-            std::vector<hpx::shared_future<result_t>> result;
-            for (auto const& elem : s)
+            // Work items without a result, e.g. the chunks of a for_loop,
+            // are valid once they complete without throwing
+            if constexpr (std::is_void<result_t>::value)
+            {
+                return detail::split_bulk_outcome(
+                    detail::bulk_replicate_void(
+                        exec_.instance(), replicate_count_, f, s, ts_pack),
+                    hpx::util::size(s));
+            }
+            else
             {
-                result.push_back(this->async_execute(
-                    std::forward<F>(f), elem, std::forward<Ts>(ts)...));
+                return detail::split_bulk_outcome(
+                    detail::bulk_replicate<result_t>(exec_.instance(),
+                        replicate_count_, validator_, f, s, ts_pack),
+                    hpx::util::size(s));
             }
+        }
+
+        template <typename F, typename Future, typename... Ts>
+        decltype(auto) then_execute(F&& f, Future&& predecessor, Ts&&... ts)
+        {
+            return detail::then_execute(*this, std::forward<F>(f),
+                std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+        }
 
-            return result;
+        template <typename F, typename S, typename Future, typename... Ts>
+        decltype(auto) bulk_then_execute(
+            F&& f, S const& s, Future&& predecessor, Ts&&... ts)
+        {
+            return detail::bulk_then_execute(*this, std::forward<F>(f), s,
+                std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+        }
+
+        // Every chunk is a single work item of the bulk kernel, a failing
+        // chunk is replicated as a whole
+        template <typename Parameters, typename F>
+        std::size_t get_chunk_size(Parameters&& params, F&& f,
+            std::size_t cores, std::size_t count) const
+        {
+            return detail::resilient_chunk_size(
+                params, *this, f, cores, count, num_spread, num_task);
         }
 
     private:
@@ -177,6 +297,216 @@ namespace hpx { namespace kokkos { namespace resiliency {
         Validate validator_;
     };
 
+    // Replicate executor which starts a single copy of every task. Further
+    // copies are launched only once the task has been running for longer
+    // than the given percentile of the latencies of recent tasks, or once all
+    // running copies have failed validation. The first valid result wins.
+    template <typename BaseExecutor, typename Validate>
+    class hedged_replicate_executor
+    {
+    public:
+        using execution_category = typename BaseExecutor::execution_category;
+        using execution_parameters_type =
+            typename hpx::parallel::execution::extract_executor_parameters<
+                BaseExecutor>::type;
+        using parameters_type = execution_parameters_type;
+        using execution_space = typename BaseExecutor::execution_space;
+
+        template <typename Result>
+        using future_type =
+            typename hpx::parallel::execution::executor_future<BaseExecutor,
+                Result>::type;
+
+        template <typename F>
+        explicit hedged_replicate_executor(
+            BaseExecutor& exec, std::size_t n, F&& f, double percentile)
+          : exec_(exec)
+          , replicate_count_(n)
+          , validator_(std::forward<F>(f))
+          , percentile_(percentile)
+          , tracker_(std::make_shared<detail::latency_tracker>())
+        {
+        }
+
+        bool operator==(hedged_replicate_executor const& rhs) const noexcept
+        {
+            return &exec_ == &rhs.exec_ && tracker_ == rhs.tracker_;
+        }
+
+        bool operator!=(hedged_replicate_executor const& rhs) const noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        hedged_replicate_executor const& context() const noexcept
+        {
+            return *this;
+        }
+
+        execution_space instance() const
+        {
+            return exec_.instance();
+        }
+
+        template <typename F, typename... Ts>
+        decltype(auto) async_execute(F&& f, Ts&&... ts)
+        {
+            // Ensure the value of n is greater than 0
+            HPX_ASSERT(replicate_count_ > 0);
+
+            using result_t =
+                typename hpx::util::detail::invoke_deferred_result<F,
+                    Ts...>::type;
+            using helper_t = detail::hedged_replicate_helper<
+                typename std::decay<BaseExecutor>::type, result_t, Validate,
+                typename std::decay<F>::type,
+                hpx::tuple<typename std::decay<Ts>::type...>>;
+
+            auto helper = std::make_shared<helper_t>(replicate_count_,
+                validator_, std::forward<F>(f),
+                hpx::make_tuple(std::forward<Ts>(ts)...), tracker_);
+
+            return helper->call(tracker_->percentile(percentile_));
+        }
+
+        template <typename F, typename Future, typename... Ts>
+        decltype(auto) then_execute(F&& f, Future&& predecessor, Ts&&... ts)
+        {
+            return detail::then_execute(*this, std::forward<F>(f),
+                std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+        }
+
+    private:
+        BaseExecutor& exec_;
+        std::size_t replicate_count_;
+        Validate validator_;
+        double percentile_;
+
+        // Shared by all copies of the executor
+        std::shared_ptr<detail::latency_tracker> tracker_;
+    };
+
+    // Resilient executor choosing between replay, hedged replication and
+    // full replication for every task. The choice minimizes the expected
+    // completion time based on the observed failure rate of the validator,
+    // the observed task duration and the number of idle workers.
+    template <typename BaseExecutor, typename Validate>
+    class adaptive_executor
+    {
+    public:
+        using execution_category = typename BaseExecutor::execution_category;
+        using execution_parameters_type =
+            typename hpx::parallel::execution::extract_executor_parameters<
+                BaseExecutor>::type;
+        using parameters_type = execution_parameters_type;
+        using execution_space = typename BaseExecutor::execution_space;
+
+        template <typename Result>
+        using future_type =
+            typename hpx::parallel::execution::executor_future<BaseExecutor,
+                Result>::type;
+
+        using validator_type = detail::counting_validator<Validate,
+            typename execution_space::memory_space>;
+
+        template <typename F>
+        explicit adaptive_executor(BaseExecutor& exec, std::size_t n, F&& f)
+          : exec_(exec)
+          , count_(n)
+          , validator_{std::forward<F>(f),
+                Kokkos::View<std::uint64_t*,
+                    typename execution_space::memory_space>(
+                    "adaptive_validations", 2)}
+          , hedged_(exec, n, validator_, 0.95)
+          , stats_(std::make_shared<detail::adaptive_statistics>())
+        {
+        }
+
+        bool operator==(adaptive_executor const& rhs) const noexcept
+        {
+            return &exec_ == &rhs.exec_ && stats_ == rhs.stats_;
+        }
+
+        bool operator!=(adaptive_executor const& rhs) const noexcept
+        {
+            return !(*this == rhs);
+        }
+
+        adaptive_executor const& context() const noexcept
+        {
+            return *this;
+        }
+
+        execution_space instance() const
+        {
+            return exec_.instance();
+        }
+
+        template <typename F, typename... Ts>
+        decltype(auto) async_execute(F&& f, Ts&&... ts)
+        {
+            using result_t =
+                typename hpx::util::detail::invoke_deferred_result<F,
+                    Ts...>::type;
+
+            detail::resilience_strategy strategy =
+                stats_->choose(count_, detail::idle_worker_count());
+            auto start = std::chrono::steady_clock::now();
+
+            hpx::future<result_t> result;
+            switch (strategy)
+            {
+            case detail::resilience_strategy::replay:
+                result = async_replay_validate(exec_, count_, validator_,
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+                break;
+
+            case detail::resilience_strategy::hedged_replicate:
+                result = hedged_.async_execute(
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+                break;
+
+            case detail::resilience_strategy::replicate:
+                result = async_replicate_validate(exec_, count_, validator_,
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+                break;
+            }
+
+            // Feed the outcome back into the estimates
+            return result.then(hpx::launch::sync,
+                [stats = stats_, counts = validator_.counts_,
+                    inst = exec_.instance(), strategy,
+                    start](hpx::future<result_t>&& f) {
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+
+                    std::uint64_t validations = 0;
+                    std::uint64_t failures = 0;
+                    detail::read_validation_counts(inst, counts,
+                        stats->next_task(), validations, failures);
+
+                    stats->update(validations, failures, strategy, elapsed);
+
+                    return f.get();
+                });
+        }
+
+        template <typename F, typename Future, typename... Ts>
+        decltype(auto) then_execute(F&& f, Future&& predecessor, Ts&&... ts)
+        {
+            return detail::then_execute(*this, std::forward<F>(f),
+                std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+        }
+
+    private:
+        BaseExecutor& exec_;
+        std::size_t count_;
+        validator_type validator_;
+        hedged_replicate_executor<BaseExecutor, validator_type> hedged_;
+
+        // Shared by all copies of the executor
+        std::shared_ptr<detail::adaptive_statistics> stats_;
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     template <typename BaseExecutor, typename Validate>
     replay_executor<BaseExecutor, typename std::decay<Validate>::type>
@@ -198,6 +528,28 @@ namespace hpx { namespace kokkos { namespace resiliency {
             exec, n, std::forward<Validate>(validate));
     }
 
+    ////////////////////////////////////////////////////////////////////////////
+    template <typename BaseExecutor, typename Validate>
+    hedged_replicate_executor<BaseExecutor, typename std::decay<Validate>::type>
+    make_hedged_replicate_executor(BaseExecutor& exec, std::size_t n,
+        Validate&& validate, double percentile = 0.95)
+    {
+        return hedged_replicate_executor<BaseExecutor,
+            typename std::decay<Validate>::type>(
+            exec, n, std::forward<Validate>(validate), percentile);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    template <typename BaseExecutor, typename Validate>
+    adaptive_executor<BaseExecutor, typename std::decay<Validate>::type>
+    make_adaptive_executor(
+        BaseExecutor& exec, std::size_t n, Validate&& validate)
+    {
+        return adaptive_executor<BaseExecutor,
+            typename std::decay<Validate>::type>(
+            exec, n, std::forward<Validate>(validate));
+    }
+
 }}}    // namespace hpx::kokkos::resiliency
 
 namespace hpx { namespace kokkos {
@@ -214,6 +566,20 @@ namespace hpx { namespace kokkos {
       : is_kokkos_executor<BaseExecutor>
     {
     };
+
+    template <typename BaseExecutor, typename Validator>
+    struct is_kokkos_executor<hpx::kokkos::resiliency::
+            hedged_replicate_executor<BaseExecutor, Validator>>
+      : is_kokkos_executor<BaseExecutor>
+    {
+    };
+
+    template <typename BaseExecutor, typename Validator>
+    struct is_kokkos_executor<
+        hpx::kokkos::resiliency::adaptive_executor<BaseExecutor, Validator>>
+      : is_kokkos_executor<BaseExecutor>
+    {
+    };
 }}    // namespace hpx::kokkos
 
 namespace hpx { namespace parallel { namespace execution {
@@ -232,6 +598,20 @@ namespace hpx { namespace parallel { namespace execution {
     {
     };
 
+    template <typename BaseExecutor, typename Validator>
+    struct is_two_way_executor<hpx::kokkos::resiliency::
+            hedged_replicate_executor<BaseExecutor, Validator>>
+      : std::true_type
+    {
+    };
+
+    template <typename BaseExecutor, typename Validator>
+    struct is_two_way_executor<
+        hpx::kokkos::resiliency::adaptive_executor<BaseExecutor, Validator>>
+      : std::true_type
+    {
+    };
+
     template <typename BaseExecutor, typename Validator>
     struct is_bulk_two_way_executor<
         hpx::kokkos::resiliency::replay_executor<BaseExecutor, Validator>>
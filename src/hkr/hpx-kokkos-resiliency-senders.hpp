@@ -0,0 +1,285 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/kokkos.hpp>
+
+#include <hkr/hpx-kokkos-resiliency-cpos.hpp>
+#include <hkr/result-slot.hpp>
+#include <hkr/util.hpp>
+
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/include/apply.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace kokkos { namespace resiliency {
+
+    namespace detail {
+
+        struct replay_strategy
+        {
+        };
+
+        struct replicate_strategy
+        {
+        };
+
+        // Launch all attempts within a single iteration, stop at the first
+        // valid one
+        template <typename ExecutionSpace, typename Result, typename Pred,
+            typename F, typename Tuple>
+        hpx::shared_future<void> launch_resilient_kernel(replay_strategy,
+            ExecutionSpace const& inst, std::size_t n, Pred const& pred,
+            F const& f, Tuple const& tuple,
+            Kokkos::View<Result*, ExecutionSpace> exec_result,
+            Kokkos::View<int*, ExecutionSpace> exec_state)
+        {
+            return hpx::kokkos::parallel_for_async("replay_validate_sender",
+                Kokkos::RangePolicy<ExecutionSpace>(inst, 0, 1),
+                KOKKOS_LAMBDA(int) {
+                    for (std::size_t i = 0u; i < n; ++i)
+                    {
+                        Result res =
+                            hpx::util::invoke_fused_r<Result>(f, tuple);
+
+                        if (pred(res))
+                        {
+                            exec_result[0] = std::move(res);
+                            exec_state[0] = result_published;
+
+                            break;
+                        }
+                    }
+                });
+        }
+
+        // Launch one iteration per replica, the first valid result wins
+        template <typename ExecutionSpace, typename Result, typename Pred,
+            typename F, typename Tuple>
+        hpx::shared_future<void> launch_resilient_kernel(replicate_strategy,
+            ExecutionSpace const& inst, std::size_t n, Pred const& pred,
+            F const& f, Tuple const& tuple,
+            Kokkos::View<Result*, ExecutionSpace> exec_result,
+            Kokkos::View<int*, ExecutionSpace> exec_state)
+        {
+            return hpx::kokkos::parallel_for_async("replicate_validate_sender",
+                Kokkos::RangePolicy<ExecutionSpace>(inst, 0, n),
+                KOKKOS_LAMBDA(int) {
+                    run_replica([&] { return result_taken(&exec_state[0]); },
+                        [&] {
+                            return hpx::util::invoke_fused_r<Result>(f, tuple);
+                        },
+                        [&](Result&& res) {
+                            if (pred(res))
+                                publish_once(&exec_state[0],
+                                    [&] { exec_result[0] = std::move(res); });
+                        });
+                });
+        }
+
+        // Run f once the kernel behind fut has completed. This is the hook
+        // future::then is built on, using it directly saves the shared state
+        // of a continuation future.
+        template <typename F>
+        void on_kernel_completed(hpx::shared_future<void> const& fut, F&& f)
+        {
+            hpx::traits::detail::get_shared_state(fut)->set_on_completed(
+                std::forward<F>(f));
+        }
+
+        // Sender wrapping the future of a replayed or replicated Kokkos
+        // kernel. Nothing is launched before the operation state is started.
+        // Once the kernel has completed, the result is copied back and the
+        // receiver is completed on a new HPX thread. HPX-Kokkos launches
+        // kernels only through futures, so every start allocates the
+        // kernel's future shared state, the result and state Views and the
+        // completion thread. Only the continuation future of the dataflow
+        // based CPOs is saved.
+        template <typename Strategy, typename ExecutionSpace, typename Result,
+            typename Pred, typename F, typename Tuple>
+        struct kernel_future_sender
+        {
+            ExecutionSpace inst_;
+            std::size_t n_;
+            Pred pred_;
+            F f_;
+            Tuple t_;
+
+            template <template <typename...> class Tuple_,
+                template <typename...> class Variant>
+            using value_types = Variant<Tuple_<Result>>;
+
+            template <template <typename...> class Variant>
+            using error_types = Variant<std::exception_ptr>;
+
+            static constexpr bool sends_done = false;
+
+            template <typename Receiver>
+            struct operation_state
+            {
+                std::decay_t<Receiver> receiver_;
+                ExecutionSpace inst_;
+                std::size_t n_;
+                Pred pred_;
+                F f_;
+                Tuple t_;
+
+                Kokkos::View<Result*, ExecutionSpace> exec_result_;
+                Kokkos::View<int*, ExecutionSpace> exec_state_;
+                hpx::shared_future<void> fut_;
+
+                template <typename Receiver_>
+                operation_state(Receiver_&& receiver, ExecutionSpace inst,
+                    std::size_t n, Pred pred, F f, Tuple tuple)
+                  : receiver_(std::forward<Receiver_>(receiver))
+                  , inst_(std::move(inst))
+                  , n_(n)
+                  , pred_(std::move(pred))
+                  , f_(std::move(f))
+                  , t_(std::move(tuple))
+                {
+                }
+
+                operation_state(operation_state&&) = delete;
+                operation_state& operator=(operation_state&&) = delete;
+                operation_state(operation_state const&) = delete;
+                operation_state& operator=(operation_state const&) = delete;
+
+                void set_result() noexcept
+                {
+                    hpx::detail::try_catch_exception_ptr(
+                        [&]() {
+                            // Throw any error reported by the kernel
+                            fut_.get();
+
+                            auto host_result =
+                                Kokkos::create_mirror_view(exec_result_);
+                            auto host_state =
+                                Kokkos::create_mirror_view(exec_state_);
+
+                            Kokkos::deep_copy(host_result, exec_result_);
+                            Kokkos::deep_copy(host_state, exec_state_);
+
+                            if (host_state[0] != result_published)
+                                throw resiliency_exception(
+                                    std::is_same<Strategy,
+                                        replay_strategy>::value ?
+                                        "Replay Exception occured." :
+                                        "Replicate Exception occured.");
+
+                            hpx::execution::experimental::set_value(
+                                std::move(receiver_),
+                                std::move(host_result[0]));
+                        },
+                        [&](std::exception_ptr ep) {
+                            hpx::execution::experimental::set_error(
+                                std::move(receiver_), std::move(ep));
+                        });
+                }
+
+                friend void tag_invoke(hpx::execution::experimental::start_t,
+                    operation_state& os) noexcept
+                {
+                    hpx::detail::try_catch_exception_ptr(
+                        [&]() {
+                            os.exec_result_ =
+                                Kokkos::View<Result*, ExecutionSpace>(
+                                    "sender_execution_space_result", 1);
+                            os.exec_state_ =
+                                Kokkos::View<int*, ExecutionSpace>(
+                                    "sender_execution_space_state", 1);
+
+                            os.fut_ = launch_resilient_kernel(Strategy{},
+                                os.inst_, os.n_, os.pred_, os.f_, os.t_,
+                                os.exec_result_, os.exec_state_);
+
+                            // The completion callback may run on a polling
+                            // or Kokkos thread, copying the result back and
+                            // completing the receiver there would block it
+                            on_kernel_completed(os.fut_, [&os]() {
+                                hpx::apply([&os]() { os.set_result(); });
+                            });
+                        },
+                        [&](std::exception_ptr ep) {
+                            hpx::execution::experimental::set_error(
+                                std::move(os.receiver_), std::move(ep));
+                        });
+                }
+            };
+
+            template <typename Receiver>
+            friend operation_state<Receiver> tag_invoke(
+                hpx::execution::experimental::connect_t,
+                kernel_future_sender&& s, Receiver&& receiver)
+            {
+                return {std::forward<Receiver>(receiver), std::move(s.inst_),
+                    s.n_, std::move(s.pred_), std::move(s.f_),
+                    std::move(s.t_)};
+            }
+
+            template <typename Receiver>
+            friend operation_state<Receiver> tag_invoke(
+                hpx::execution::experimental::connect_t,
+                kernel_future_sender const& s, Receiver&& receiver)
+            {
+                return {std::forward<Receiver>(receiver), s.inst_, s.n_,
+                    s.pred_, s.f_, s.t_};
+            }
+        };
+
+        template <typename Strategy, typename ExecutionSpace, typename Pred,
+            typename F, typename... Ts>
+        kernel_future_sender<Strategy, ExecutionSpace,
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type,
+            typename std::decay<Pred>::type, typename std::decay<F>::type,
+            hpx::tuple<typename std::decay<Ts>::type...>>
+        make_kernel_future_sender(ExecutionSpace const& inst, std::size_t n,
+            Pred&& pred, F&& f, Ts&&... ts)
+        {
+            return {inst, n, std::forward<Pred>(pred), std::forward<F>(f),
+                hpx::make_tuple(std::forward<Ts>(ts)...)};
+        }
+    }    // namespace detail
+
+    // Sender counterpart of async_replay_validate. Like the future based
+    // version, all attempts run on an independent instance. The sender
+    // wraps the kernel's future, so starting it still allocates a shared
+    // state, see detail::kernel_future_sender.
+    template <typename Executor, typename Pred, typename F, typename... Ts,
+        HPX_CONCEPT_REQUIRES_(
+            hpx::traits::is_two_way_executor<Executor>::value)>
+    decltype(auto) tag_invoke(replay_validate_sender_t, Executor&& exec,
+        std::size_t n, Pred&& pred, F&& f, Ts&&... ts)
+    {
+        // Ensure the value of n is greater than 0
+        HPX_ASSERT(n > 0);
+
+        using execution_space =
+            typename std::decay<Executor>::type::execution_space;
+
+        return detail::make_kernel_future_sender<detail::replay_strategy>(
+            hpx::kokkos::detail::make_independent_execution_space_instance<
+                execution_space>(),
+            n, std::forward<Pred>(pred), std::forward<F>(f),
+            std::forward<Ts>(ts)...);
+    }
+
+    // Sender counterpart of async_replicate_validate, with the same
+    // allocations as replay_validate_sender
+    template <typename Executor, typename Pred, typename F, typename... Ts,
+        HPX_CONCEPT_REQUIRES_(
+            hpx::traits::is_two_way_executor<Executor>::value)>
+    decltype(auto) tag_invoke(replicate_validate_sender_t, Executor&& exec,
+        std::size_t n, Pred&& pred, F&& f, Ts&&... ts)
+    {
+        return detail::make_kernel_future_sender<detail::replicate_strategy>(
+            exec.instance(), n, std::forward<Pred>(pred), std::forward<F>(f),
+            std::forward<Ts>(ts)...);
+    }
+
+}}}    // namespace hpx::kokkos::resiliency
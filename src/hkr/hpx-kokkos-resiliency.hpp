@@ -4,13 +4,20 @@
 
 #include <hpx/kokkos.hpp>
 
+#include <hkr/bulk-execution.hpp>
 #include <hkr/hpx-kokkos-resiliency-cpos.hpp>
 #include <hkr/hpx-kokkos-resiliency-executor.hpp>
+#include <hkr/performance-counters.hpp>
+#include <hkr/placement.hpp>
+#include <hkr/result-slot.hpp>
+#include <hkr/traits.hpp>
 #include <hkr/util.hpp>
 
+#include <hpx/chrono.hpp>
 #include <hpx/future.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <exception>
 #include <memory>
 #include <tuple>
@@ -47,73 +54,383 @@ namespace hpx { namespace kokkos { namespace resiliency {
                     bool result = pred(res);
 
                     if (result)
-                        return hpx::make_tuple(true, std::move(res));
+                        return hpx::make_tuple(true, i + 1, std::move(res));
                 }
 
-                return hpx::make_tuple(false, result_t{});
+                return hpx::make_tuple(false, n, result_t{});
             })
-            .then([](hpx::future<hpx::tuple<bool, result_t>>&& f) {
-                // Get pair
+            .then([](hpx::future<hpx::tuple<bool, std::size_t, result_t>>&&
+                         f) {
+                // Get validity, number of attempts and result
                 auto&& result = f.get();
 
+                detail::record_task(hpx::get<1>(result), !hpx::get<0>(result));
+
                 if (!hpx::get<0>(result))
                     throw detail::resiliency_exception(
                         "Replay Exception occured.");
 
-                return hpx::get<1>(std::move(result));
+                return hpx::get<2>(std::move(result));
             });
     }
 
+    namespace detail {
+
+        // Replays one attempt per kernel launch and checks the deadline
+        // before launching the next one. In split mode the next attempt is
+        // scheduled as a separate task on a fresh independent instance.
+        template <typename Result, typename Pred, typename F, typename Tuple>
+        struct async_replay_chain_helper
+          : std::enable_shared_from_this<
+                async_replay_chain_helper<Result, Pred, F, Tuple>>
+        {
+            template <typename Pred_, typename F_, typename Tuple_>
+            async_replay_chain_helper(Pred_&& pred, F_&& f, Tuple_&& tuple,
+                std::chrono::steady_clock::time_point deadline,
+                bool split = false)
+              : pred_(std::forward<Pred_>(pred))
+              , f_(std::forward<F_>(f))
+              , t_(std::forward<Tuple_>(tuple))
+              , deadline_(deadline)
+              , split_(split)
+            {
+            }
+
+            template <typename Executor>
+            hpx::future<Result> call(Executor exec, std::size_t n)
+            {
+                if (std::chrono::steady_clock::now() >= deadline_)
+                {
+                    record_task(attempts_, true);
+
+                    return hpx::make_exceptional_future<Result>(
+                        resiliency_timeout_exception(
+                            "Replay time budget exceeded."));
+                }
+
+                ++attempts_;
+
+                auto pred = pred_;
+                auto f = f_;
+                auto tuple = t_;
+
+                hpx::future<hpx::tuple<bool, Result>> attempt =
+                    hpx::async(exec, KOKKOS_LAMBDA() {
+                        Result res =
+                            hpx::util::invoke_fused_r<Result>(f, tuple);
+
+                        bool result = pred(res);
+
+                        return hpx::make_tuple(result, std::move(res));
+                    });
+
+                auto this_ = this->shared_from_this();
+                return attempt.then(
+                    split_ ? hpx::launch::async : hpx::launch::sync,
+                    [this_ = std::move(this_), exec = std::move(exec), n](
+                        hpx::future<hpx::tuple<bool, Result>>&& f) mutable
+                    -> hpx::future<Result> {
+                        auto&& result = f.get();
+
+                        if (hpx::get<0>(result))
+                        {
+                            record_task(this_->attempts_, false);
+
+                            return hpx::make_ready_future(
+                                hpx::get<1>(std::move(result)));
+                        }
+
+                        if (n <= 1)
+                        {
+                            record_task(this_->attempts_, true);
+
+                            return hpx::make_exceptional_future<Result>(
+                                resiliency_exception(
+                                    "Replay Exception occured."));
+                        }
+
+                        if (this_->split_)
+                        {
+                            return this_->call(
+                                Executor{hpx::kokkos::execution_space_mode::
+                                        independent},
+                                n - 1);
+                        }
+
+                        return this_->call(std::move(exec), n - 1);
+                    });
+            }
+
+            Pred pred_;
+            F f_;
+            Tuple t_;
+            std::chrono::steady_clock::time_point deadline_;
+            bool split_;
+            std::size_t attempts_ = 0;
+        };
+    }    // namespace detail
+
+    // Time bounded variant of async_replay_validate. Attempts are launched one
+    // after another until one passes validation, n attempts have been made or
+    // the budget is spent, in which case the future holds a
+    // resiliency_timeout_exception.
     template <typename Executor, typename Pred, typename F, typename... Ts,
         HPX_CONCEPT_REQUIRES_(
             hpx::traits::is_two_way_executor<Executor>::value)>
     hpx::future<
         typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
-    tag_invoke(async_replicate_validate_t, Executor&& exec, std::size_t n,
+    tag_invoke(async_replay_validate_for_t, Executor&& exec,
+        hpx::chrono::steady_duration const& budget, std::size_t n,
         Pred&& pred, F&& f, Ts&&... ts)
     {
-        // Generate necessary components
+        // Ensure the value of n is greater than 0
+        HPX_ASSERT(n > 0);
+
+        using result_t =
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type;
+        using independent_exec = typename std::decay<Executor>::type;
+        using tuple_t = hpx::tuple<typename std::decay<Ts>::type...>;
+        using helper_t = detail::async_replay_chain_helper<result_t,
+            typename std::decay<Pred>::type, typename std::decay<F>::type,
+            tuple_t>;
+
+        auto helper = std::make_shared<helper_t>(std::forward<Pred>(pred),
+            std::forward<F>(f), hpx::make_tuple(std::forward<Ts>(ts)...),
+            detail::make_deadline(budget.value()));
+
+        // All attempts share a single independent instance
+        return helper->call(
+            independent_exec{hpx::kokkos::execution_space_mode::independent},
+            n);
+    }
+
+    // Variant of async_replay_validate running every attempt as a separate
+    // task. The worker is released between attempts, and every attempt runs
+    // on a fresh independent instance.
+    template <typename Executor, typename Pred, typename F, typename... Ts,
+        HPX_CONCEPT_REQUIRES_(
+            hpx::traits::is_two_way_executor<Executor>::value)>
+    hpx::future<
+        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
+    tag_invoke(async_replay_validate_split_t, Executor&& exec, std::size_t n,
+        Pred&& pred, F&& f, Ts&&... ts)
+    {
+        // Ensure the value of n is greater than 0
+        HPX_ASSERT(n > 0);
+
         using result_t =
             typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type;
+        using independent_exec = typename std::decay<Executor>::type;
+        using tuple_t = hpx::tuple<typename std::decay<Ts>::type...>;
+        using helper_t = detail::async_replay_chain_helper<result_t,
+            typename std::decay<Pred>::type, typename std::decay<F>::type,
+            tuple_t>;
+
+        auto helper = std::make_shared<helper_t>(std::forward<Pred>(pred),
+            std::forward<F>(f), hpx::make_tuple(std::forward<Ts>(ts)...),
+            std::chrono::steady_clock::time_point::max(), true);
+
+        return helper->call(
+            independent_exec{hpx::kokkos::execution_space_mode::independent},
+            n);
+    }
+
+    // Batched variant of async_replay_validate. Every index in [0, range) is
+    // replayed independently (up to n times) within a single kernel launch.
+    // The future holds the per-index results and a mask flagging the indices
+    // for which no attempt passed validation.
+    template <typename Executor, typename Pred, typename F, typename... Ts,
+        HPX_CONCEPT_REQUIRES_(
+            hpx::traits::is_two_way_executor<Executor>::value)>
+    hpx::future<hpx::tuple<
+        Kokkos::View<typename hpx::util::detail::invoke_deferred_result<F,
+                         std::size_t, Ts...>::type*,
+            Kokkos::DefaultHostExecutionSpace>,
+        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>>>
+    tag_invoke(async_replay_validate_n_t, Executor&& exec, std::size_t range,
+        std::size_t n, Pred&& pred, F&& f, Ts&&... ts)
+    {
+        // Generate necessary components
+        using result_t = typename hpx::util::detail::invoke_deferred_result<F,
+            std::size_t, Ts...>::type;
+        using execution_space =
+            typename std::decay<Executor>::type::execution_space;
+        using index_pack_type = typename hpx::util::detail::fused_index_pack<
+            hpx::tuple<typename std::decay<Ts>::type...>>::type;
+
         auto tuple = hpx::make_tuple(std::forward<Ts>(ts)...);
 
         Kokkos::View<result_t*, Kokkos::DefaultHostExecutionSpace> host_result(
-            "host_result", 1);
-        Kokkos::View<result_t*,
-            typename std::decay<Executor>::type::execution_space>
-            exec_result("execution_space_result", 1);
-
-        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> host_bool(
-            "host_bool", 1);
-        Kokkos::View<bool*,
-            typename std::decay<Executor>::type::execution_space>
-            exec_bool("execution_space_bool", 1);
-
-        hpx::for_loop(
-            hpx::kokkos::kok.on(exec).label("replicate_validate"), 0u, n,
-            KOKKOS_LAMBDA(std::size_t i) {
-                result_t res = hpx::util::invoke_fused_r<result_t>(f, tuple);
-
-                bool result = pred(res);
-
-                // Store only the first valid result generated
-                if (result)
+            "host_result_n", range);
+        Kokkos::View<result_t*, execution_space> exec_result(
+            "execution_space_result_n", range);
+
+        Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace> host_failed(
+            "host_failed_n", range);
+        Kokkos::View<bool*, execution_space> exec_failed(
+            "execution_space_failed_n", range);
+
+        Kokkos::View<std::size_t*, Kokkos::DefaultHostExecutionSpace>
+            host_replays("host_replays_n", 1);
+        Kokkos::View<std::size_t*, execution_space> exec_replays(
+            "execution_space_replays_n", 1);
+
+        hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+            "replay_validate_n",
+            Kokkos::RangePolicy<execution_space>(exec.instance(), 0, range),
+            KOKKOS_LAMBDA(int idx) {
+                // Ensure the value of n is greater than 0
+                HPX_ASSERT(n > 0);
+
+                std::size_t i = static_cast<std::size_t>(idx);
+
+                for (std::size_t j = 0u; j < n; ++j)
                 {
-                    if (!Kokkos::atomic_exchange(&exec_bool[0], true))
-                        exec_result[0] = std::move(res);
+                    result_t res = detail::invoke_indexed_r<result_t>(
+                        index_pack_type{}, f, i, tuple);
+
+                    if (pred(res))
+                    {
+                        exec_result[i] = std::move(res);
+
+                        if (j != 0)
+                            Kokkos::atomic_add(&exec_replays[0], j);
+                        return;
+                    }
                 }
+
+                exec_failed[i] = true;
+                Kokkos::atomic_add(&exec_replays[0], n - 1);
             });
 
-        Kokkos::deep_copy(host_result, exec_result);
-        Kokkos::deep_copy(host_bool, exec_bool);
+        return fut.then(hpx::launch::sync,
+            [=](hpx::shared_future<void>&& f) {
+                // Throw any error reported by the kernel
+                f.get();
+
+                Kokkos::deep_copy(host_result, exec_result);
+                Kokkos::deep_copy(host_failed, exec_failed);
+                Kokkos::deep_copy(host_replays, exec_replays);
+
+                detail::record_tasks(range, range + host_replays[0],
+                    detail::count_failures(host_failed));
+
+                return hpx::make_tuple(host_result, host_failed);
+            });
+    }
+
+    template <typename Executor, typename Pred, typename F, typename... Ts,
+        HPX_CONCEPT_REQUIRES_(
+            hpx::traits::is_two_way_executor<Executor>::value)>
+    hpx::future<
+        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
+    tag_invoke(async_replicate_validate_t, Executor&& exec, std::size_t n,
+        Pred&& pred, F&& f, Ts&&... ts)
+    {
+        // Generate necessary components
+        using result_t =
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type;
+        using execution_space =
+            typename std::decay<Executor>::type::execution_space;
+        auto tuple = hpx::make_tuple(std::forward<Ts>(ts)...);
+
+        if constexpr (!hpx::kokkos::traits::is_device_execution_space<
+                          execution_space>::value)
+        {
+            // The winning replica moves its result into the slot, from
+            // which it is moved into the returned future after the kernel
+            auto slot =
+                std::make_shared<detail::host_result_slot<result_t>>();
+
+            hpx::for_loop(
+                hpx::kokkos::kok.on(exec).label("replicate_validate"), 0u, n,
+                KOKKOS_LAMBDA(std::size_t i) {
+                    // Replicas are counted when they start, so that failing
+                    // replicas count as well
+                    detail::run_replica([&] { return slot->published(); },
+                        [&] {
+                            ++slot->attempts;
+                            return hpx::util::invoke_fused_r<result_t>(
+                                f, tuple);
+                        },
+                        [&](result_t&& res) {
+                            if (pred(res))
+                                slot->publish(std::move(res));
+                        });
+                });
+
+            detail::record_task(slot->attempts, !slot->published());
+
+            if (!slot->complete())
+                slot->promise.set_exception(
+                    std::make_exception_ptr(detail::resiliency_exception(
+                        "Replicate Exception occured.")));
+
+            return slot->promise.get_future();
+        }
+        else
+        {
+            detail::device_result_slot<result_t, execution_space> slot;
+
+            hpx::for_loop(
+                hpx::kokkos::kok.on(exec).label("replicate_validate"), 0u, n,
+                KOKKOS_LAMBDA(std::size_t) {
+                    bool ran = detail::run_replica(
+                        [&] { return slot.published(); },
+                        [&] {
+                            return hpx::util::invoke_fused_r<result_t>(
+                                f, tuple);
+                        },
+                        [&](result_t&& res) {
+                            // Publish only the first valid result generated
+                            if (pred(res))
+                                slot.publish(std::move(res));
+                        });
+
+                    if (ran)
+                        slot.count_replica();
+                });
+
+            auto status = slot.get_status();
+
+            detail::record_task(status.replicas, !status.published);
+
+            if (!status.published)
+                return hpx::make_exceptional_future<result_t>(
+                    detail::resiliency_exception(
+                        "Replicate Exception occured."));
+
+            return hpx::make_ready_future(slot.get());
+        }
+    }
+
+    // Variant of async_replicate_validate on host executors, running every
+    // replica as a separate task placed by the placement policy, see
+    // hkr/placement.hpp
+    template <typename Executor, typename Placement, typename Pred,
+        typename F, typename... Ts,
+        HPX_CONCEPT_REQUIRES_(
+            hpx::traits::is_two_way_executor<Executor>::value)>
+    hpx::future<
+        typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type>
+    tag_invoke(async_replicate_validate_placed_t, Executor&& exec,
+        Placement const& placement, std::size_t n, Pred&& pred, F&& f,
+        Ts&&... ts)
+    {
+        using result_t =
+            typename hpx::util::detail::invoke_deferred_result<F, Ts...>::type;
+        using execution_space =
+            typename std::decay<Executor>::type::execution_space;
+
+        static_assert(!hpx::kokkos::traits::is_device_execution_space<
+                          execution_space>::value,
+            "Replicas can only be placed on host execution spaces");
 
-        return hpx::async(hpx::launch::sync, [&]() {
-            if (host_bool[0])
-                return host_result[0];
+        // Ensure the value of n is greater than 0
+        HPX_ASSERT(n > 0);
 
-            throw detail::resiliency_exception("Replicate Exception occured.");
-            return host_result[0];
-        });
+        return detail::place_replicas<result_t>(placement, n, pred, f,
+            hpx::make_tuple(std::forward<Ts>(ts)...));
     }
 
 }}}    // namespace hpx::kokkos::resiliency
\ No newline at end of file
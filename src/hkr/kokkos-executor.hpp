@@ -1,18 +1,316 @@
 #pragma once
 
+#include <hpx/chrono.hpp>
+#include <hpx/include/apply.hpp>
 #include <hpx/kokkos.hpp>
+#include <hpx/modules/synchronization.hpp>
 #include <Kokkos_Core.hpp>
 
+#include <hkr/bulk-execution.hpp>
+#include <hkr/performance-counters.hpp>
+#include <hkr/placement.hpp>
+#include <hkr/result-slot.hpp>
+#include <hkr/then-execution.hpp>
 #include <hkr/traits.hpp>
 #include <hkr/util.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace hpx {
     namespace kokkos {
         namespace experimental {
             namespace resiliency {
 
+    namespace detail {
+
+        // Launch a window of attempts at once, the first valid attempt wins.
+        // The next window is launched only once every attempt of the current
+        // window has failed. On devices, all windows publish into the same
+        // device_result_slot, attempts counts the attempts which ran in
+        // earlier windows.
+        template <typename Result, typename ExecutionSpace, typename Pred,
+            typename F, typename Tuple>
+        hpx::future<Result> speculative_replay_device(
+            ExecutionSpace const& inst, std::size_t n, std::size_t window,
+            Pred const& pred, F const& f, Tuple const& tuple,
+            std::chrono::steady_clock::time_point deadline,
+            hpx::kokkos::resiliency::detail::device_result_slot<Result,
+                ExecutionSpace> const& slot,
+            std::size_t attempts = 0)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                hpx::kokkos::resiliency::detail::record_task(attempts, true);
+
+                return hpx::make_exceptional_future<Result>(
+                    hpx::kokkos::resiliency::detail::
+                        resiliency_timeout_exception(
+                            "Replay time budget exceeded."));
+            }
+
+            std::size_t count = (std::min)(window, n);
+
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "speculative_replay",
+                Kokkos::RangePolicy<ExecutionSpace>(inst, 0, count),
+                KOKKOS_LAMBDA(int) {
+                    // Skip attempts starting after a valid result was
+                    // published
+                    bool ran = hpx::kokkos::resiliency::detail::run_replica(
+                        [&] { return slot.published(); },
+                        [&] {
+                            return hpx::util::invoke_fused_r<Result>(
+                                f, tuple);
+                        },
+                        [&](Result&& res) {
+                            if (pred(res))
+                                slot.publish(std::move(res));
+                        });
+
+                    if (ran)
+                        slot.count_replica();
+                });
+
+            return fut.then(hpx::launch::sync,
+                [=](hpx::shared_future<void>&& done) -> hpx::future<Result> {
+                    // Throw any error reported by the kernel
+                    done.get();
+
+                    auto status = slot.get_status();
+
+                    if (status.published)
+                    {
+                        hpx::kokkos::resiliency::detail::record_task(
+                            status.replicas, false);
+
+                        return hpx::make_ready_future(slot.get());
+                    }
+
+                    if (count == n)
+                    {
+                        hpx::kokkos::resiliency::detail::record_task(
+                            status.replicas, true);
+
+                        return hpx::make_exceptional_future<Result>(
+                            hpx::kokkos::resiliency::detail::
+                                resiliency_exception(
+                                    "Replay Execption Occured."));
+                    }
+
+                    return speculative_replay_device<Result>(inst,
+                        n - count, window, pred, f, tuple, deadline, slot,
+                        status.replicas);
+                });
+        }
+
+        // Same on host execution spaces. The first valid attempt moves its
+        // result into the slot, whose future is made ready once the last
+        // window has completed.
+        template <typename Result, typename ExecutionSpace, typename Pred,
+            typename F, typename Tuple>
+        void speculative_replay_host(ExecutionSpace const& inst,
+            std::size_t n, std::size_t window, Pred const& pred, F const& f,
+            Tuple const& tuple, std::chrono::steady_clock::time_point deadline,
+            std::shared_ptr<
+                hpx::kokkos::resiliency::detail::host_result_slot<Result>>
+                slot)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                hpx::kokkos::resiliency::detail::record_task(
+                    slot->attempts, true);
+
+                slot->promise.set_exception(std::make_exception_ptr(
+                    hpx::kokkos::resiliency::detail::
+                        resiliency_timeout_exception(
+                            "Replay time budget exceeded.")));
+                return;
+            }
+
+            std::size_t count = (std::min)(window, n);
+
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "speculative_replay",
+                Kokkos::RangePolicy<ExecutionSpace>(inst, 0, count),
+                KOKKOS_LAMBDA(int) {
+                    // Attempts are counted when they start, so that failing
+                    // attempts count as well
+                    hpx::kokkos::resiliency::detail::run_replica(
+                        [&] { return slot->published(); },
+                        [&] {
+                            ++slot->attempts;
+                            return hpx::util::invoke_fused_r<Result>(
+                                f, tuple);
+                        },
+                        [&](Result&& res) {
+                            if (pred(res))
+                                slot->publish(std::move(res));
+                        });
+                });
+
+            fut.then(hpx::launch::sync,
+                [=](hpx::shared_future<void>&& done) {
+                    bool valid = slot->published();
+
+                    if (valid || count == n || done.has_exception())
+                    {
+                        hpx::kokkos::resiliency::detail::record_task(
+                            slot->attempts, !valid);
+
+                        slot->complete(done,
+                            hpx::kokkos::resiliency::detail::
+                                resiliency_exception(
+                                    "Replay Execption Occured."));
+                        return;
+                    }
+
+                    speculative_replay_host<Result>(inst, n - count, window,
+                        pred, f, tuple, deadline, slot);
+                });
+        }
+
+        // Replay with a window of attempts in flight. Both paths share the
+        // publication protocol of the replicate executors, so results may be
+        // move-only on host execution spaces.
+        template <typename Result, typename ExecutionSpace, typename Pred,
+            typename F, typename Tuple>
+        hpx::future<Result> speculative_replay(ExecutionSpace const& inst,
+            std::size_t n, std::size_t window, Pred const& pred, F const& f,
+            Tuple const& tuple, std::chrono::steady_clock::time_point deadline)
+        {
+            if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                              ExecutionSpace>::value)
+            {
+                return speculative_replay_device<Result>(inst, n, window,
+                    pred, f, tuple, deadline,
+                    hpx::kokkos::resiliency::detail::device_result_slot<
+                        Result, ExecutionSpace>());
+            }
+            else
+            {
+                auto slot = std::make_shared<
+                    hpx::kokkos::resiliency::detail::host_result_slot<
+                        Result>>();
+                hpx::future<Result> result = slot->promise.get_future();
+
+                speculative_replay_host<Result>(
+                    inst, n, window, pred, f, tuple, deadline, slot);
+
+                return result;
+            }
+        }
+
+        // Number of independent HPX instances owned by a host executor
+        constexpr std::size_t instance_pool_size = 4;
+
+        // Independent HPX instances shared by the copies of an executor,
+        // created once along with the executor. A task checks out an idle
+        // instance and returns it once its kernel has completed. While every
+        // instance is busy, acquire suspends the calling HPX thread until an
+        // instance is returned, a burst of tasks never creates new instances.
+        class instance_pool
+        {
+        public:
+            explicit instance_pool(std::size_t size)
+              : available_(static_cast<std::int64_t>(size))
+            {
+                idle_.reserve(size);
+                for (std::size_t i = 0; i != size; ++i)
+                    idle_.emplace_back(Kokkos::Experimental::HPX::
+                            instance_mode::independent);
+            }
+
+            Kokkos::Experimental::HPX acquire()
+            {
+                available_.wait();
+
+                std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+                Kokkos::Experimental::HPX inst = idle_.back();
+                idle_.pop_back();
+                return inst;
+            }
+
+            void release(Kokkos::Experimental::HPX const& inst)
+            {
+                {
+                    std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+                    idle_.push_back(inst);
+                }
+                available_.signal();
+            }
+
+        private:
+            hpx::lcos::local::spinlock mtx_;
+            hpx::lcos::local::counting_semaphore available_;
+            std::vector<Kokkos::Experimental::HPX> idle_;
+        };
+
+        // Device execution spaces don't need host instances
+        template <typename ExecutionSpace>
+        std::shared_ptr<instance_pool> make_instance_pool()
+        {
+            if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                              ExecutionSpace>::value)
+                return nullptr;
+            else
+                return std::make_shared<instance_pool>(instance_pool_size);
+        }
+
+        // Instance checked out of the pool for as long as any pinned copy of
+        // an executor is alive
+        class pinned_instance
+        {
+        public:
+            explicit pinned_instance(std::shared_ptr<instance_pool> pool)
+              : pool_(std::move(pool))
+              , inst_(pool_->acquire())
+            {
+            }
+
+            pinned_instance(pinned_instance const&) = delete;
+            pinned_instance& operator=(pinned_instance const&) = delete;
+
+            ~pinned_instance()
+            {
+                pool_->release(inst_);
+            }
+
+            Kokkos::Experimental::HPX const& get() const
+            {
+                return inst_;
+            }
+
+        private:
+            std::shared_ptr<instance_pool> pool_;
+            Kokkos::Experimental::HPX inst_;
+        };
+
+        // Return inst to the pool once f is ready
+        template <typename Future>
+        typename std::decay<Future>::type release_after(
+            std::shared_ptr<instance_pool> const& pool,
+            Kokkos::Experimental::HPX const& inst, Future&& f)
+        {
+            using future_t = typename std::decay<Future>::type;
+
+            future_t fut = std::forward<Future>(f);
+            return std::move(fut).then(hpx::launch::sync,
+                [pool, inst](future_t&& done) {
+                    pool->release(inst);
+                    return std::move(done);
+                });
+        }
+    }    // namespace detail
+
     template <typename ExecutionSpace, typename Validate>
     class replay_executor
     {
@@ -26,6 +324,30 @@ namespace hpx {
           : inst_(instance)
           , replay_count_(n)
           , validator_(std::forward<F>(f))
+          , budget_(std::chrono::steady_clock::duration::max())
+        {
+        }
+
+        // Replay stops once budget has elapsed since the task was submitted
+        template <typename F>
+        explicit replay_executor(execution_space const& instance,
+            std::size_t n, F&& f, hpx::chrono::steady_duration const& budget)
+          : inst_(instance)
+          , replay_count_(n)
+          , validator_(std::forward<F>(f))
+          , budget_(budget.value())
+        {
+        }
+
+        // Keep up to window attempts in flight at once
+        template <typename F>
+        explicit replay_executor(execution_space const& instance,
+            std::size_t n, F&& f, std::size_t window)
+          : inst_(instance)
+          , replay_count_(n)
+          , validator_(std::forward<F>(f))
+          , budget_(std::chrono::steady_clock::duration::max())
+          , window_(window)
         {
         }
 
@@ -41,47 +363,64 @@ namespace hpx {
                 typename hpx::util::detail::invoke_deferred_result<F,
                     Ts...>::type;
 
-            return hpx::async(
-                [&inst = inst_, n = replay_count_, pred = validator_,
-                    func = std::forward<F>(f),
-                    ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...)]() {
-                    // Initialize result to be returned
-                    Kokkos::View<return_t*, execution_space> exec_result(
-                        "device_execution_space_result", 1);
-                    Kokkos::View<return_t*, Kokkos::DefaultHostExecutionSpace>
-                        host_result("device_host_result", 1);
+            std::size_t n = replay_count_;
+            auto pred = validator_;
+            auto func = std::forward<F>(f);
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-                    Kokkos::View<bool*, execution_space> exec_bool(
-                        "device_execution_space_bool", 1);
-                    Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>
-                        host_bool("device_host_bool", 1);
+            // Initialize result to be returned
+            Kokkos::View<return_t*, execution_space> exec_result(
+                "device_execution_space_result", 1);
+            Kokkos::View<bool*, execution_space> exec_bool(
+                "device_execution_space_bool", 1);
+            Kokkos::View<std::size_t*, execution_space> exec_attempts(
+                "device_execution_space_attempts", 1);
 
-                    Kokkos::parallel_for(
-                        "async_replay",
-                        Kokkos::RangePolicy<execution_space>(inst, 0, 1),
-                        KOKKOS_LAMBDA(int) {
-                            for (std::size_t i = 0; i < n; ++i)
-                            {
-                                return_t res =
-                                    hpx::util::invoke_fused_r<return_t>(
-                                        func, ts_pack);
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "async_replay",
+                Kokkos::RangePolicy<execution_space>(inst_, 0, 1),
+                KOKKOS_LAMBDA(int) {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        exec_attempts[0] = i + 1;
 
-                                bool valid = pred(res);
+                        return_t res =
+                            hpx::util::invoke_fused_r<return_t>(func, ts_pack);
 
-                                if (valid)
-                                {
-                                    exec_result[0] = res;
-                                    exec_bool[0] = true;
+                        bool valid = pred(res);
 
-                                    break;
-                                }
-                            }
-                        });
-                    // Let parallel_for run to completion
-                    inst.fence();
+                        if (valid)
+                        {
+                            exec_result[0] = res;
+                            exec_bool[0] = true;
+
+                            break;
+                        }
+                    }
+                });
+
+            // Results are copied back once the kernel has completed, no fence
+            // is needed
+            return fut.then(hpx::launch::sync,
+                [exec_result, exec_bool, exec_attempts](
+                    hpx::shared_future<void>&& f) {
+                    // Throw any error reported by the kernel
+                    f.get();
+
+                    Kokkos::View<return_t*, Kokkos::DefaultHostExecutionSpace>
+                        host_result("device_host_result", 1);
+                    Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>
+                        host_bool("device_host_bool", 1);
+                    Kokkos::View<std::size_t*,
+                        Kokkos::DefaultHostExecutionSpace>
+                        host_attempts("device_host_attempts", 1);
 
                     Kokkos::deep_copy(host_result, exec_result);
                     Kokkos::deep_copy(host_bool, exec_bool);
+                    Kokkos::deep_copy(host_attempts, exec_attempts);
+
+                    hpx::kokkos::resiliency::detail::record_task(
+                        host_attempts[0], !host_bool[0]);
 
                     if (host_bool[0])
                         return std::move(host_result[0]);
@@ -98,68 +437,231 @@ namespace hpx {
                 typename hpx::util::detail::invoke_deferred_result<F,
                     Ts...>::type;
 
-            return hpx::async(
-                [&inst = inst_, n = replay_count_, pred = validator_,
-                    func = std::forward<F>(f),
-                    ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...)]() {
-                    // Initialize result to be returned
-                    Kokkos::View<return_t*, execution_space> exec_result(
-                        "host_execution_space_result", 1);
-
-                    Kokkos::View<bool*, execution_space> exec_bool(
-                        "host_execution_space_bool", 1);
-
-                    Kokkos::Experimental::HPX hpx_inst{
-                        Kokkos::Experimental::HPX::instance_mode::independent};
-
-                    Kokkos::parallel_for(
-                        "async_replay",
-                        Kokkos::RangePolicy<execution_space>(hpx_inst, 0, 1),
-                        KOKKOS_LAMBDA(int) {
-                            for (std::size_t i = 0; i < n; ++i)
-                            {
-                                return_t res =
-                                    hpx::util::invoke_fused_r<return_t>(
-                                        func, ts_pack);
+            // The budget is measured from the point the task is submitted
+            auto deadline =
+                hpx::kokkos::resiliency::detail::make_deadline(budget_);
 
-                                bool valid = pred(res);
+            std::size_t n = replay_count_;
+            auto pred = validator_;
+            auto func = std::forward<F>(f);
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-                                if (valid)
-                                {
-                                    exec_result[0] = std::move(res);
-                                    exec_bool[0] = true;
+            auto slot = std::make_shared<
+                hpx::kokkos::resiliency::detail::host_result_slot<return_t>>();
+            hpx::future<return_t> result = slot->promise.get_future();
 
-                                    break;
-                                }
-                            }
-                        });
-                    // Let parallel_for run to completion
-                    hpx_inst.fence();
+            // Pinned copies keep their instance, other copies return it to
+            // the pool once the kernel has completed
+            execution_space hpx_inst =
+                pinned_ ? pinned_->get() : instances_->acquire();
+            std::shared_ptr<detail::instance_pool> instances =
+                pinned_ ? nullptr : instances_;
 
-                    if (exec_bool[0])
-                        return std::move(exec_result[0]);
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "async_replay",
+                Kokkos::RangePolicy<execution_space>(hpx_inst, 0, 1),
+                KOKKOS_LAMBDA(int) {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        if (std::chrono::steady_clock::now() >= deadline)
+                        {
+                            slot->timeout = true;
+                            break;
+                        }
 
-                    throw hpx::kokkos::resiliency::detail::resiliency_exception(
-                        "Replay Execption Occured.");
+                        slot->attempts = i + 1;
+
+                        return_t res =
+                            hpx::util::invoke_fused_r<return_t>(func, ts_pack);
+
+                        auto start = std::chrono::steady_clock::now();
+                        bool valid = pred(res);
+                        hpx::kokkos::resiliency::detail::record_validator_time(
+                            std::chrono::steady_clock::now() - start);
+
+                        if (valid)
+                        {
+                            slot->publish(std::move(res));
+                            break;
+                        }
+                    }
+                });
+
+            // The worker is released while the kernel runs, the result or
+            // failure is reported once it has completed
+            fut.then(hpx::launch::sync,
+                [slot, instances, hpx_inst](hpx::shared_future<void>&& f) {
+                    if (instances)
+                        instances->release(hpx_inst);
+
+                    hpx::kokkos::resiliency::detail::record_task(
+                        slot->attempts, !slot->published());
+
+                    if (slot->timeout)
+                        slot->complete(f,
+                            hpx::kokkos::resiliency::detail::
+                                resiliency_timeout_exception(
+                                    "Replay time budget exceeded."));
+                    else
+                        slot->complete(f,
+                            hpx::kokkos::resiliency::detail::
+                                resiliency_exception(
+                                    "Replay Execption Occured."));
                 });
+
+            return result;
+        }
+
+        template <typename F, typename... Ts>
+        decltype(auto) speculative_execution(F&& f, Ts&&... ts)
+        {
+            using return_t =
+                typename hpx::util::detail::invoke_deferred_result<F,
+                    Ts...>::type;
+
+            auto deadline =
+                hpx::kokkos::resiliency::detail::make_deadline(budget_);
+
+            // All windows of a task run on the same instance
+            return on_instance([&](execution_space const& inst) {
+                return detail::speculative_replay<return_t>(inst,
+                    replay_count_, window_, validator_, std::forward<F>(f),
+                    hpx::make_tuple(std::forward<Ts>(ts)...), deadline);
+            });
         }
 
         template <typename F, typename... Ts>
         decltype(auto) async_execute(F&& f, Ts&&... ts)
         {
+            if (window_ > 1)
+                return speculative_execution(
+                    std::forward<F>(f), std::forward<Ts>(ts)...);
+
             if constexpr (hpx::kokkos::traits::is_device_execution_space<
                               execution_space>::value)
+            {
+                // A device kernel can't read the host clock, a budgeted
+                // replay launches one attempt per kernel and checks the
+                // deadline in between
+                if (budget_ != std::chrono::steady_clock::duration::max())
+                    return speculative_execution(
+                        std::forward<F>(f), std::forward<Ts>(ts)...);
+
                 return device_execution(
                     std::forward<F>(f), std::forward<Ts>(ts)...);
+            }
             else
                 return host_execution(
                     std::forward<F>(f), std::forward<Ts>(ts)...);
         }
 
+        // Every element of the shape is replayed independently within a
+        // single kernel, the results of all elements share one View
+        template <typename F, typename S, typename... Ts>
+        decltype(auto) bulk_async_execute(F&& f, S const& s, Ts&&... ts)
+        {
+            using return_t =
+                typename hpx::util::detail::invoke_deferred_result<F,
+                    decltype(*hpx::util::begin(s)), Ts...>::type;
+
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
+
+            // Work items without a result are valid once they complete
+            // without throwing
+            if constexpr (std::is_void<return_t>::value)
+            {
+                return hpx::kokkos::resiliency::detail::split_bulk_outcome(
+                    on_instance([&](execution_space const& inst) {
+                        return hpx::kokkos::resiliency::detail::
+                            bulk_replay_void(
+                                inst, replay_count_, f, s, ts_pack);
+                    }),
+                    hpx::util::size(s));
+            }
+            else
+            {
+                return hpx::kokkos::resiliency::detail::split_bulk_outcome(
+                    on_instance([&](execution_space const& inst) {
+                        return hpx::kokkos::resiliency::detail::bulk_replay<
+                            return_t>(inst, replay_count_, validator_, f, s,
+                            ts_pack);
+                    }),
+                    hpx::util::size(s));
+            }
+        }
+
+        // Copy of the executor running all its tasks and continuations on
+        // one instance of the pool, queued in the order they are launched.
+        // The instance goes back to the pool once the last pinned copy is
+        // destroyed. Device executors always run on their own instance.
+        replay_executor pin() const
+        {
+            replay_executor pinned(*this);
+
+            if constexpr (!hpx::kokkos::traits::is_device_execution_space<
+                              execution_space>::value)
+            {
+                if (!pinned_)
+                    pinned.pinned_ =
+                        std::make_shared<detail::pinned_instance>(instances_);
+            }
+
+            return pinned;
+        }
+
+        // The next kernel is launched as soon as the predecessor has
+        // completed, without an additional scheduling step. It is queued on
+        // the instance of the executor, which is the predecessor's instance
+        // on devices and on pinned copies, so the stages of a pipeline
+        // built on a pinned copy all run on the same instance. Otherwise it
+        // checks out an idle instance like any task.
+        template <typename F, typename Future, typename... Ts>
+        decltype(auto) then_execute(F&& f, Future&& predecessor, Ts&&... ts)
+        {
+            return hpx::kokkos::resiliency::detail::then_execute(*this,
+                std::forward<F>(f), std::forward<Future>(predecessor),
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename S, typename Future, typename... Ts>
+        decltype(auto) bulk_then_execute(
+            F&& f, S const& s, Future&& predecessor, Ts&&... ts)
+        {
+            return hpx::kokkos::resiliency::detail::bulk_then_execute(*this,
+                std::forward<F>(f), s, std::forward<Future>(predecessor),
+                std::forward<Ts>(ts)...);
+        }
+
     private:
+        // Device kernels run on the executor's instance. Host kernels run on
+        // the pinned instance, if any, or on an idle instance of the pool,
+        // which is returned once the future returned by launch is ready.
+        template <typename Launch>
+        decltype(auto) on_instance(Launch&& launch) const
+        {
+            if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                              execution_space>::value)
+                return launch(inst_);
+            else
+            {
+                if (pinned_)
+                    return launch(pinned_->get());
+
+                execution_space inst = instances_->acquire();
+                return detail::release_after(instances_, inst, launch(inst));
+            }
+        }
+
         execution_space inst_;
         std::size_t replay_count_;
         Validate validator_;
+        std::chrono::steady_clock::duration budget_;
+        std::size_t window_ = 1;
+
+        // Shared by all copies of the executor
+        std::shared_ptr<detail::instance_pool> instances_ =
+            detail::make_instance_pool<execution_space>();
+        std::shared_ptr<detail::pinned_instance> pinned_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -174,18 +676,49 @@ namespace hpx {
     }
 
     template <typename ExecutionSpace, typename Validate>
+    replay_executor<ExecutionSpace, typename std::decay<Validate>::type>
+    make_replay_executor(ExecutionSpace const& inst, std::size_t n,
+        Validate&& validate, hpx::chrono::steady_duration const& budget)
+    {
+        return replay_executor<ExecutionSpace,
+            typename std::decay<Validate>::type>(
+            inst, n, std::forward<Validate>(validate), budget);
+    }
+
+    template <typename ExecutionSpace, typename Validate>
+    replay_executor<ExecutionSpace, typename std::decay<Validate>::type>
+    make_speculative_replay_executor(ExecutionSpace const& inst,
+        std::size_t n, Validate&& validate, std::size_t window)
+    {
+        return replay_executor<ExecutionSpace,
+            typename std::decay<Validate>::type>(
+            inst, n, std::forward<Validate>(validate), window);
+    }
+
+    // The placement policy decides where the replicas of a task run on
+    // host execution spaces, see hkr/placement.hpp
+    template <typename ExecutionSpace, typename Validate,
+        typename Placement = hpx::kokkos::resiliency::default_placement>
     class replicate_executor
     {
+        static_assert(
+            std::is_same<Placement,
+                hpx::kokkos::resiliency::default_placement>::value ||
+                !hpx::kokkos::traits::is_device_execution_space<
+                    ExecutionSpace>::value,
+            "Replicas can only be placed on host execution spaces");
+
     public:
         using execution_space = ExecutionSpace;
         using execution_category = hpx::execution::parallel_execution_tag;
 
         template <typename F>
-        explicit replicate_executor(
-            execution_space const& instance, std::size_t n, F&& f)
+        explicit replicate_executor(execution_space const& instance,
+            std::size_t n, F&& f, Placement const& placement = Placement{})
           : inst_(instance)
           , replicate_count_(n)
           , validator_(std::forward<F>(f))
+          , placement_(placement)
         {
         }
 
@@ -201,48 +734,53 @@ namespace hpx {
                 typename hpx::util::detail::invoke_deferred_result<F,
                     Ts...>::type;
 
-            return hpx::async([&inst = inst_, n = replicate_count_,
-                                  pred = validator_, func = std::forward<F>(f),
-                                  ts_pack = hpx::make_tuple(
-                                      std::forward<Ts>(ts)...)]() {
-                // Initialize result to be returned
-                Kokkos::View<return_t*, execution_space> exec_result(
-                    "device_execution_space_result", 1);
-                Kokkos::View<return_t*, Kokkos::DefaultHostExecutionSpace>
-                    host_result("device_host_result", 1);
-
-                Kokkos::View<bool*, execution_space> exec_bool(
-                    "device_execution_space_bool", 1);
-                Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>
-                    host_bool("device_host_bool", 1);
-
-                Kokkos::parallel_for(
-                    "async_replay",
-                    Kokkos::RangePolicy<execution_space>(inst, 0, n),
-                    KOKKOS_LAMBDA(int) {
-                        return_t res =
-                            hpx::util::invoke_fused_r<return_t>(func, ts_pack);
+            std::size_t n = replicate_count_;
+            auto pred = validator_;
+            auto func = std::forward<F>(f);
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-                        bool valid = pred(res);
+            // All replicas share a single result
+            hpx::kokkos::resiliency::detail::device_result_slot<return_t,
+                execution_space>
+                slot;
 
-                        if (valid)
-                        {
-                            if (!Kokkos::atomic_exchange(&exec_bool[0], true))
-                                exec_result[0] = std::move(res);
-                        }
-                    });
-                // Let parallel_for run to completion
-                inst.fence();
+            hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
+                "async_replay",
+                Kokkos::RangePolicy<execution_space>(inst_, 0, n),
+                KOKKOS_LAMBDA(int) {
+                    bool ran = hpx::kokkos::resiliency::detail::run_replica(
+                        [&] { return slot.published(); },
+                        [&] {
+                            return hpx::util::invoke_fused_r<return_t>(
+                                func, ts_pack);
+                        },
+                        [&](return_t&& res) {
+                            if (pred(res))
+                                slot.publish(std::move(res));
+                        });
+
+                    if (ran)
+                        slot.count_replica();
+                });
 
-                Kokkos::deep_copy(host_result, exec_result);
-                Kokkos::deep_copy(host_bool, exec_bool);
+            // Results are copied back once the kernel has completed, no fence
+            // is needed
+            return fut.then(hpx::launch::sync,
+                [slot](hpx::shared_future<void>&& f) {
+                    // Throw any error reported by the kernel
+                    f.get();
 
-                if (host_bool[0])
-                    return std::move(host_result[0]);
+                    auto status = slot.get_status();
 
-                throw hpx::kokkos::resiliency::detail::resiliency_exception(
-                    "Replicate Execption Occured.");
-            });
+                    hpx::kokkos::resiliency::detail::record_task(
+                        status.replicas, !status.published);
+
+                    if (status.published)
+                        return slot.get();
+
+                    throw hpx::kokkos::resiliency::detail::resiliency_exception(
+                        "Replicate Execption Occured.");
+                });
         }
 
         template <typename F, typename... Ts>
@@ -252,44 +790,87 @@ namespace hpx {
                 typename hpx::util::detail::invoke_deferred_result<F,
                     Ts...>::type;
 
-            return hpx::async([&inst = inst_, n = replicate_count_,
-                                  pred = validator_, func = std::forward<F>(f),
-                                  ts_pack = hpx::make_tuple(
-                                      std::forward<Ts>(ts)...)]() {
-                // Initialize result to be returned
-                Kokkos::View<return_t*, execution_space> exec_result(
-                    "host_execution_space_result", 1);
+            std::size_t n = replicate_count_;
+            auto pred = validator_;
+            auto func = std::forward<F>(f);
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
 
-                Kokkos::View<bool*, execution_space> exec_bool(
-                    "host_execution_space_bool", 1);
+            using default_placement =
+                hpx::kokkos::resiliency::default_placement;
+
+            // Replicas placed by a policy run as separate tasks
+            if constexpr (!std::is_same<Placement, default_placement>::value)
+            {
+                return hpx::kokkos::resiliency::detail::place_replicas<
+                    return_t>(placement_, n, pred, func, ts_pack);
+            }
+            else
+            {
+                auto slot = std::make_shared<hpx::kokkos::resiliency::detail::
+                        host_result_slot<return_t>>();
+                hpx::future<return_t> result = slot->promise.get_future();
 
-                Kokkos::Experimental::HPX hpx_inst{
-                    Kokkos::Experimental::HPX::instance_mode::independent};
+                // Pinned copies keep their instance, other copies return it
+                // to the pool once the kernel has completed
+                execution_space hpx_inst =
+                    pinned_ ? pinned_->get() : instances_->acquire();
+                std::shared_ptr<detail::instance_pool> instances =
+                    pinned_ ? nullptr : instances_;
 
-                Kokkos::parallel_for(
+                hpx::shared_future<void> fut = hpx::kokkos::parallel_for_async(
                     "async_replay",
-                    Kokkos::RangePolicy<execution_space>(hpx_inst, 0, n),
+                    // One replica per chunk so that unstarted replicas can
+                    // be skipped individually
+                    Kokkos::RangePolicy<execution_space>(
+                        hpx_inst, 0, n, Kokkos::ChunkSize(1)),
                     KOKKOS_LAMBDA(int) {
-                        return_t res =
-                            hpx::util::invoke_fused_r<return_t>(func, ts_pack);
-
-                        bool valid = pred(res);
+                        // Replicas are counted when they start, so that
+                        // failing replicas count as well
+                        hpx::kokkos::resiliency::detail::run_replica(
+                            [&] { return slot->published(); },
+                            [&] {
+                                ++slot->attempts;
+                                return hpx::util::invoke_fused_r<return_t>(
+                                    func, ts_pack);
+                            },
+                            [&](return_t&& res) {
+                                auto start =
+                                    std::chrono::steady_clock::now();
+                                bool valid = pred(res);
+                                hpx::kokkos::resiliency::detail::
+                                    record_validator_time(
+                                        std::chrono::steady_clock::now() -
+                                        start);
 
-                        if (valid)
-                        {
-                            if (!Kokkos::atomic_exchange(&exec_bool[0], true))
-                                exec_result[0] = std::move(res);
-                        }
+                                // The future becomes ready as soon as a
+                                // valid result is published. Its
+                                // continuations run in a separate task, not
+                                // within the kernel.
+                                if (valid && slot->publish(std::move(res)))
+                                    hpx::apply([slot] { slot->complete(); });
+                            });
                     });
-                // Let parallel_for run to completion
-                hpx_inst.fence();
 
-                if (exec_bool[0])
-                    return std::move(exec_result[0]);
+                // The worker is released while the kernel runs, a failure is
+                // reported once every replica has completed
+                fut.then(hpx::launch::sync,
+                    [slot, instances, hpx_inst](hpx::shared_future<void>&& f) {
+                        if (instances)
+                            instances->release(hpx_inst);
 
-                throw hpx::kokkos::resiliency::detail::resiliency_exception(
-                    "Replicate Execption Occured.");
-            });
+                        bool published = slot->published();
+                        hpx::kokkos::resiliency::detail::record_task(
+                            slot->attempts, !published);
+
+                        if (!published)
+                            slot->fail(f,
+                                hpx::kokkos::resiliency::detail::
+                                    resiliency_exception(
+                                        "Replicate Execption Occured."));
+                    });
+
+                return result;
+            }
         }
 
         template <typename F, typename... Ts>
@@ -304,10 +885,108 @@ namespace hpx {
                     std::forward<F>(f), std::forward<Ts>(ts)...);
         }
 
+        // Every element of the shape is replicated independently within a
+        // single kernel, the results of all elements share one View
+        template <typename F, typename S, typename... Ts>
+        decltype(auto) bulk_async_execute(F&& f, S const& s, Ts&&... ts)
+        {
+            using return_t =
+                typename hpx::util::detail::invoke_deferred_result<F,
+                    decltype(*hpx::util::begin(s)), Ts...>::type;
+
+            auto ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...);
+
+            // Work items without a result are valid once they complete
+            // without throwing
+            if constexpr (std::is_void<return_t>::value)
+            {
+                return hpx::kokkos::resiliency::detail::split_bulk_outcome(
+                    on_instance([&](execution_space const& inst) {
+                        return hpx::kokkos::resiliency::detail::
+                            bulk_replicate_void(
+                                inst, replicate_count_, f, s, ts_pack);
+                    }),
+                    hpx::util::size(s));
+            }
+            else
+            {
+                return hpx::kokkos::resiliency::detail::split_bulk_outcome(
+                    on_instance([&](execution_space const& inst) {
+                        return hpx::kokkos::resiliency::detail::bulk_replicate<
+                            return_t>(inst, replicate_count_, validator_, f, s,
+                            ts_pack);
+                    }),
+                    hpx::util::size(s));
+            }
+        }
+
+        // Copy of the executor running all its tasks and continuations on
+        // one instance of the pool, queued in the order they are launched.
+        // The instance goes back to the pool once the last pinned copy is
+        // destroyed. Device executors always run on their own instance.
+        replicate_executor pin() const
+        {
+            replicate_executor pinned(*this);
+
+            if constexpr (!hpx::kokkos::traits::is_device_execution_space<
+                              execution_space>::value)
+            {
+                if (!pinned_)
+                    pinned.pinned_ =
+                        std::make_shared<detail::pinned_instance>(instances_);
+            }
+
+            return pinned;
+        }
+
+        // Continuations run on the predecessor's instance on devices and on
+        // pinned copies, like those of replay_executor
+        template <typename F, typename Future, typename... Ts>
+        decltype(auto) then_execute(F&& f, Future&& predecessor, Ts&&... ts)
+        {
+            return hpx::kokkos::resiliency::detail::then_execute(*this,
+                std::forward<F>(f), std::forward<Future>(predecessor),
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename S, typename Future, typename... Ts>
+        decltype(auto) bulk_then_execute(
+            F&& f, S const& s, Future&& predecessor, Ts&&... ts)
+        {
+            return hpx::kokkos::resiliency::detail::bulk_then_execute(*this,
+                std::forward<F>(f), s, std::forward<Future>(predecessor),
+                std::forward<Ts>(ts)...);
+        }
+
     private:
+        // Device kernels run on the executor's instance. Host kernels run on
+        // the pinned instance, if any, or on an idle instance of the pool,
+        // which is returned once the future returned by launch is ready.
+        template <typename Launch>
+        decltype(auto) on_instance(Launch&& launch) const
+        {
+            if constexpr (hpx::kokkos::traits::is_device_execution_space<
+                              execution_space>::value)
+                return launch(inst_);
+            else
+            {
+                if (pinned_)
+                    return launch(pinned_->get());
+
+                execution_space inst = instances_->acquire();
+                return detail::release_after(instances_, inst, launch(inst));
+            }
+        }
+
         execution_space inst_;
         std::size_t replicate_count_;
         Validate validator_;
+        Placement placement_;
+
+        // Shared by all copies of the executor
+        std::shared_ptr<detail::instance_pool> instances_ =
+            detail::make_instance_pool<execution_space>();
+        std::shared_ptr<detail::pinned_instance> pinned_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -321,6 +1000,17 @@ namespace hpx {
             inst, n, std::forward<Validate>(validate));
     }
 
+    template <typename ExecutionSpace, typename Validate, typename Placement>
+    replicate_executor<ExecutionSpace, typename std::decay<Validate>::type,
+        Placement>
+    make_replicate_executor(ExecutionSpace const& inst, std::size_t n,
+        Validate&& validate, Placement const& placement)
+    {
+        return replicate_executor<ExecutionSpace,
+            typename std::decay<Validate>::type, Placement>(
+            inst, n, std::forward<Validate>(validate), placement);
+    }
+
 }}}}    // namespace hpx::kokkos::experimental::resiliency
 
 namespace hpx { namespace parallel { namespace execution {
@@ -331,9 +1021,23 @@ namespace hpx { namespace parallel { namespace execution {
     {
     };
 
-    template <typename ExecutionSpace, typename Validator>
+    template <typename ExecutionSpace, typename Validator, typename Placement>
     struct is_two_way_executor<hpx::kokkos::experimental::resiliency::
-            replicate_executor<ExecutionSpace, Validator>> : std::true_type
+            replicate_executor<ExecutionSpace, Validator, Placement>>
+      : std::true_type
+    {
+    };
+
+    template <typename ExecutionSpace, typename Validator>
+    struct is_bulk_two_way_executor<hpx::kokkos::experimental::resiliency::
+            replay_executor<ExecutionSpace, Validator>> : std::true_type
+    {
+    };
+
+    template <typename ExecutionSpace, typename Validator, typename Placement>
+    struct is_bulk_two_way_executor<hpx::kokkos::experimental::resiliency::
+            replicate_executor<ExecutionSpace, Validator, Placement>>
+      : std::true_type
     {
     };
 
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace kokkos { namespace resiliency {
+
+    namespace detail {
+
+        // Counters owned by a single OS thread. Updates are relaxed and never
+        // contended, readers sum up the blocks of all threads.
+        struct counter_block
+        {
+            std::atomic<std::uint64_t> tasks{0};
+            std::atomic<std::uint64_t> replays{0};
+            std::atomic<std::uint64_t> failures{0};
+            std::atomic<std::uint64_t> validator_ns{0};
+        };
+
+        struct counter_registry
+        {
+            std::mutex mtx;
+            std::vector<std::shared_ptr<counter_block>> blocks;
+
+            // Baseline of the derived attempts-per-task counter
+            std::uint64_t base_tasks = 0;
+            std::uint64_t base_replays = 0;
+        };
+
+        inline counter_registry& get_counter_registry()
+        {
+            static counter_registry registry;
+            return registry;
+        }
+
+        inline counter_block& local_counters()
+        {
+            thread_local std::shared_ptr<counter_block> block = [] {
+                auto b = std::make_shared<counter_block>();
+
+                auto& registry = get_counter_registry();
+                std::lock_guard<std::mutex> l(registry.mtx);
+                registry.blocks.push_back(b);
+
+                return b;
+            }();
+
+            return *block;
+        }
+
+        // Record the outcome of resilient tasks. Attempts include the first
+        // execution of every task, replicas count as attempts.
+        inline void record_tasks(
+            std::uint64_t tasks, std::uint64_t attempts, std::uint64_t failures)
+        {
+            auto& counters = local_counters();
+
+            counters.tasks.fetch_add(tasks, std::memory_order_relaxed);
+            counters.replays.fetch_add(
+                attempts - tasks, std::memory_order_relaxed);
+            counters.failures.fetch_add(failures, std::memory_order_relaxed);
+        }
+
+        inline void record_task(std::uint64_t attempts, bool failed)
+        {
+            record_tasks(1, attempts, failed ? 1 : 0);
+        }
+
+        inline void record_validator_time(std::chrono::nanoseconds elapsed)
+        {
+            local_counters().validator_ns.fetch_add(
+                elapsed.count(), std::memory_order_relaxed);
+        }
+
+        inline std::uint64_t accumulate_counter(
+            std::atomic<std::uint64_t> counter_block::*counter, bool reset)
+        {
+            auto& registry = get_counter_registry();
+            std::lock_guard<std::mutex> l(registry.mtx);
+
+            std::uint64_t total = 0;
+            for (auto const& block : registry.blocks)
+            {
+                total += reset ?
+                    ((*block).*counter).exchange(0, std::memory_order_relaxed) :
+                    ((*block).*counter).load(std::memory_order_relaxed);
+            }
+
+            return total;
+        }
+
+        inline std::int64_t get_replays(bool reset)
+        {
+            return accumulate_counter(&counter_block::replays, reset);
+        }
+
+        inline std::int64_t get_failures(bool reset)
+        {
+            return accumulate_counter(&counter_block::failures, reset);
+        }
+
+        inline std::int64_t get_validator_time(bool reset)
+        {
+            return accumulate_counter(&counter_block::validator_ns, reset);
+        }
+
+        // Average number of attempts per task since the last reset, in
+        // thousandths of an attempt
+        inline std::int64_t get_attempts_per_task(bool reset)
+        {
+            std::uint64_t tasks =
+                accumulate_counter(&counter_block::tasks, false);
+            std::uint64_t replays =
+                accumulate_counter(&counter_block::replays, false);
+
+            auto& registry = get_counter_registry();
+            std::lock_guard<std::mutex> l(registry.mtx);
+
+            std::uint64_t num_tasks = tasks - registry.base_tasks;
+            std::uint64_t num_replays = replays - registry.base_replays;
+
+            if (reset)
+            {
+                registry.base_tasks = tasks;
+                registry.base_replays = replays;
+            }
+
+            if (num_tasks == 0)
+                return 0;
+
+            return (1000 * (num_tasks + num_replays)) / num_tasks;
+        }
+
+        inline void install_counter_types()
+        {
+            using hpx::performance_counters::install_counter_type;
+
+            install_counter_type("/resiliency-kokkos/replays", &get_replays,
+                "returns the number of attempts of resilient tasks beyond "
+                "their first execution");
+            install_counter_type("/resiliency-kokkos/failures", &get_failures,
+                "returns the number of resilient tasks for which no attempt "
+                "passed validation");
+            install_counter_type("/resiliency-kokkos/attempts-per-task",
+                &get_attempts_per_task,
+                "returns the average number of attempts per resilient task",
+                "0.001");
+            install_counter_type("/resiliency-kokkos/validator-time",
+                &get_validator_time,
+                "returns the time spent in validators running on the host",
+                "ns");
+        }
+    }    // namespace detail
+
+    // Make the resiliency counters, e.g.
+    // /resiliency-kokkos{locality#*/total}/replays, available to HPX. This
+    // may be called before the runtime is started so that the counters can
+    // be used with --hpx:print-counter.
+    inline void register_counter_types()
+    {
+        if (hpx::is_running())
+            detail::install_counter_types();
+        else
+            hpx::register_startup_function(&detail::install_counter_types);
+    }
+
+}}}    // namespace hpx::kokkos::resiliency
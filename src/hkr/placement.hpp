@@ -0,0 +1,268 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/execution.hpp>
+#include <hpx/future.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/errors.hpp>
+#include <hpx/modules/format.hpp>
+#include <hpx/topology/topology.hpp>
+
+#include <hkr/performance-counters.hpp>
+#include <hkr/result-slot.hpp>
+#include <hkr/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace kokkos { namespace resiliency {
+
+    // Placement policies other than default_placement are only supported on
+    // host execution spaces, by the experimental replicate_executor and by
+    // async_replicate_validate_placed. Every replica gets its own copy of
+    // the read-only host Views among its arguments, first touched on the
+    // cores it runs on. ResilientReplicate and async_replicate_validate run
+    // all replicas within one Kokkos kernel and can't place them.
+
+    // Replicas run within a single kernel wherever the scheduler puts them
+    struct default_placement
+    {
+    };
+
+    // Replicas run as separate tasks spread round robin over the NUMA
+    // domains of the machine
+    struct numa_placement
+    {
+        numa_placement()
+          : num_domains_((std::max)(std::size_t(1),
+                hpx::threads::get_topology().get_number_of_numa_nodes()))
+        {
+        }
+
+        hpx::execution::parallel_executor executor(std::size_t replica) const
+        {
+            return hpx::execution::parallel_executor(
+                hpx::threads::thread_priority::default_,
+                hpx::threads::thread_stacksize::default_,
+                hpx::threads::thread_schedule_hint(
+                    hpx::threads::thread_schedule_hint_mode::numa,
+                    static_cast<std::int16_t>(replica % num_domains_)));
+        }
+
+    private:
+        std::size_t num_domains_;
+    };
+
+    // Replicas run as separate tasks on named thread pools, replica i on
+    // pool i modulo the number of pools
+    struct pool_placement
+    {
+        explicit pool_placement(std::vector<std::string> pools)
+          : pools_(std::move(pools))
+        {
+            HPX_ASSERT(!pools_.empty());
+        }
+
+        hpx::execution::parallel_executor executor(std::size_t replica) const
+        {
+            return hpx::execution::parallel_executor(
+                &hpx::resource::get_thread_pool(
+                    pools_[replica % pools_.size()]));
+        }
+
+    private:
+        std::vector<std::string> pools_;
+    };
+
+    // Set up num_pools thread pools for replicas through the resource
+    // partitioner, e.g. from the rp_callback of hpx::init_params. Every pool
+    // owns cores_per_pool cores. Cores are taken from the end of the NUMA
+    // domains and alternate between domains, so that consecutive pools are
+    // located on different domains. The remaining cores stay with the
+    // default pool, which needs at least one core. Throws bad_parameter if
+    // the pools don't fit. Returns the names of the pools, to be passed to
+    // pool_placement.
+    inline std::vector<std::string> create_replica_pools(
+        hpx::resource::partitioner& rp, std::size_t num_pools,
+        std::size_t cores_per_pool = 1,
+        std::string const& prefix = "replica-pool-")
+    {
+        std::vector<hpx::resource::core const*> cores;
+        std::size_t max_cores = 0;
+        for (auto const& domain : rp.numa_domains())
+            max_cores = (std::max)(max_cores, domain.cores().size());
+
+        for (std::size_t i = 0; i != max_cores; ++i)
+        {
+            for (auto const& domain : rp.numa_domains())
+            {
+                auto const& domain_cores = domain.cores();
+                if (i < domain_cores.size())
+                    cores.push_back(&domain_cores[domain_cores.size() - 1 - i]);
+            }
+        }
+
+        // Leave at least one core to the default pool
+        if (num_pools == 0 || cores_per_pool == 0 ||
+            num_pools * cores_per_pool + 1 > cores.size())
+        {
+            // HPX_THROW_EXCEPTION only takes a preformatted message on
+            // older HPX versions
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "create_replica_pools",
+                hpx::util::format(
+                    "cannot create {} replica pools of {} cores on {} cores",
+                    num_pools, cores_per_pool, cores.size()));
+        }
+
+        std::vector<std::string> pools;
+        pools.reserve(num_pools);
+
+        for (std::size_t i = 0; i != num_pools; ++i)
+        {
+            pools.push_back(prefix + std::to_string(i));
+            rp.create_thread_pool(pools.back());
+
+            for (std::size_t j = 0; j != cores_per_pool; ++j)
+                rp.add_resource(*cores[i + j * num_pools], pools.back());
+        }
+
+        return pools;
+    }
+
+    namespace detail {
+
+        // Views of const data in host accessible memory, which replicas only
+        // read and can therefore copy
+        template <typename T, typename Enable = void>
+        struct is_staged_view : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_staged_view<T,
+            typename std::enable_if<Kokkos::is_view<T>::value>::type>
+          : std::integral_constant<bool,
+                std::is_const<typename T::value_type>::value &&
+                    T::traits::is_managed &&
+                    Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                        typename T::memory_space>::accessible>
+        {
+        };
+
+        // Copy a read-only View into a new allocation. The copy is filled
+        // serially by the calling thread, so that its pages are first
+        // touched on the NUMA domain the replica runs on, a parallel
+        // deep_copy would touch them from any core. Other arguments are
+        // passed on as they are.
+        template <typename T>
+        decltype(auto) stage_argument(T const& arg)
+        {
+            if constexpr (is_staged_view<T>::value)
+            {
+                if (!arg.span_is_contiguous())
+                    return T(arg);
+
+                typename T::non_const_type copy(
+                    Kokkos::view_alloc(
+                        Kokkos::WithoutInitializing, arg.label()),
+                    arg.layout());
+                std::copy(arg.data(), arg.data() + arg.span(), copy.data());
+
+                return T(copy);
+            }
+            else
+            {
+                return arg;
+            }
+        }
+
+        template <typename Tuple>
+        auto stage_arguments(Tuple const& tuple)
+        {
+            return hpx::util::invoke_fused(
+                [](auto const&... ts) {
+                    return hpx::tuple<decltype(stage_argument(ts))...>(
+                        stage_argument(ts)...);
+                },
+                tuple);
+        }
+
+        // Run every replica as a separate task on the executor chosen by
+        // the placement policy. Replicas run outside of Kokkos. Each replica
+        // stages the read-only Views among the inputs within its task, all
+        // other inputs are shared by the replicas.
+        template <typename Result, typename Placement, typename Pred,
+            typename F, typename Tuple>
+        hpx::future<Result> place_replicas(Placement const& placement,
+            std::size_t n, Pred const& pred, F const& f, Tuple const& tuple)
+        {
+            auto slot = std::make_shared<host_result_slot<Result>>();
+            hpx::future<Result> result = slot->promise.get_future();
+
+            std::vector<hpx::future<void>> replicas;
+            replicas.reserve(n);
+
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                replicas.push_back(hpx::async(placement.executor(i),
+                    [slot, pred, f, tuple]() {
+                        // Replicas are counted when they start, so that
+                        // failing replicas count as well
+                        run_replica([&] { return slot->published(); },
+                            [&] {
+                                ++slot->attempts;
+                                auto staged = stage_arguments(tuple);
+                                return hpx::util::invoke_fused_r<Result>(
+                                    f, staged);
+                            },
+                            [&](Result&& res) {
+                                // The future becomes ready as soon as a
+                                // valid result is published
+                                if (pred(res) && slot->publish(std::move(res)))
+                                    slot->complete();
+                            });
+                    }));
+            }
+
+            hpx::when_all(std::move(replicas))
+                .then(hpx::launch::sync,
+                    [slot](hpx::future<std::vector<hpx::future<void>>>&& f) {
+                        auto replicas = f.get();
+
+                        bool published = slot->published();
+                        record_task(slot->attempts, !published);
+
+                        if (published)
+                            return;
+
+                        // Report the first error raised by a replica
+                        for (auto& replica : replicas)
+                        {
+                            if (replica.has_exception())
+                            {
+                                slot->promise.set_exception(
+                                    replica.get_exception_ptr());
+                                return;
+                            }
+                        }
+
+                        slot->promise.set_exception(
+                            std::make_exception_ptr(resiliency_exception(
+                                "Replicate Exception occured.")));
+                    });
+
+            return result;
+        }
+    }    // namespace detail
+
+}}}    // namespace hpx::kokkos::resiliency
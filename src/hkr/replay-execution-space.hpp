@@ -2,6 +2,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <hkr/performance-counters.hpp>
 #include <hkr/util.hpp>
 
 #include <cstdint>
@@ -21,7 +22,7 @@ namespace Kokkos {
               : functor(f)
               , validator(v)
               , replays(n)
-              , incorrect_("result_correctness", 1)
+              , counts_("replay_counts", 2)
             {
             }
 
@@ -34,28 +35,33 @@ namespace Kokkos {
                     bool is_correct = validator(i, result);
 
                     if (is_correct)
-                        break;
-
-                    if (n == replays - 1)
-                        incorrect_[0] = true;
+                    {
+                        Kokkos::atomic_add(&counts_[0], n + 1);
+                        return;
+                    }
                 }
+
+                Kokkos::atomic_add(&counts_[0], replays);
+                Kokkos::atomic_add(&counts_[1], std::uint64_t(1));
             }
 
-            bool is_incorrect() const
+            // Number of attempts and of indices without a valid result
+            Kokkos::View<std::uint64_t*, Kokkos::DefaultHostExecutionSpace>
+            counts() const
             {
-                Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>
-                    return_result("is_correct", 1);
+                Kokkos::View<std::uint64_t*, Kokkos::DefaultHostExecutionSpace>
+                    return_counts("replay_host_counts", 2);
 
-                Kokkos::deep_copy(return_result, incorrect_);
+                Kokkos::deep_copy(return_counts, counts_);
 
-                return return_result[0];
+                return return_counts;
             }
 
         private:
             const Functor functor;
             const Validator validator;
             std::uint64_t replays;
-            Kokkos::View<bool*, ExecutionSpace> incorrect_;
+            Kokkos::View<std::uint64_t*, ExecutionSpace> counts_;
         };
 
     }    // namespace Impl
@@ -144,7 +150,11 @@ namespace Kokkos {
                 base_type closure(inst, m_policy);
                 closure.execute();
 
-                if (inst.is_incorrect())
+                auto counts = inst.counts();
+                hpx::kokkos::resiliency::detail::record_tasks(
+                    m_policy.end() - m_policy.begin(), counts[0], counts[1]);
+
+                if (counts[1] != 0)
                     throw std::runtime_error(
                         "Program ran out of replay options.");
             }
@@ -2,6 +2,7 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <hkr/performance-counters.hpp>
 #include <hkr/util.hpp>
 
 #include <cstdint>
@@ -21,7 +22,7 @@ namespace Kokkos {
               : functor(f)
               , validator(v)
               , replicates(n)
-              , incorrect_("result_correctness", 1)
+              , failures_("replicate_failures", 1)
             {
             }
 
@@ -47,24 +48,25 @@ namespace Kokkos {
                 }
 
                 if (!is_valid)
-                    incorrect_[0] = true;
+                    Kokkos::atomic_add(&failures_[0], std::uint64_t(1));
             }
 
-            bool is_incorrect() const
+            // Number of indices without a valid result
+            std::uint64_t failures() const
             {
-                Kokkos::View<bool*, Kokkos::DefaultHostExecutionSpace>
-                    return_result("is_correct", 1);
+                Kokkos::View<std::uint64_t*, Kokkos::DefaultHostExecutionSpace>
+                    return_failures("replicate_host_failures", 1);
 
-                Kokkos::deep_copy(return_result, incorrect_);
+                Kokkos::deep_copy(return_failures, failures_);
 
-                return return_result[0];
+                return return_failures[0];
             }
 
         private:
             const Functor functor;
             const Validator validator;
             std::uint64_t replicates;
-            Kokkos::View<bool*, ExecutionSpace> incorrect_;
+            Kokkos::View<std::uint64_t*, ExecutionSpace> failures_;
         };
 
     }    // namespace Impl
@@ -154,7 +156,13 @@ namespace Kokkos {
                 base_type closure(inst, m_policy);
                 closure.execute();
 
-                if (inst.is_incorrect())
+                // Every replica of every index runs
+                std::uint64_t tasks = m_policy.end() - m_policy.begin();
+                std::uint64_t failures = inst.failures();
+                hpx::kokkos::resiliency::detail::record_tasks(tasks,
+                    tasks * m_policy.space().replicates(), failures);
+
+                if (failures != 0)
                     throw std::runtime_error(
                         "All replicate returned incorrect result.");
             }
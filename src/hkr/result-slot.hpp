@@ -0,0 +1,180 @@
+#pragma once
+
+#include <Kokkos_Core.hpp>
+
+#include <hpx/future.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
+
+    // States of a result shared by the replicas of a task
+    enum result_state
+    {
+        result_empty = 0,
+        result_claimed = 1,
+        result_published = 2
+    };
+
+    // Result of a task running on a host execution space. The first valid
+    // result claims the slot with a compare and swap, is stored and only
+    // then marked as published with a release store. Readers check the
+    // state with an acquire load, so a published result can be read while
+    // other replicas are still running. No Views are allocated, the result
+    // is never copied and may be move-only.
+    template <typename Result>
+    struct host_result_slot
+    {
+        hpx::lcos::local::promise<Result> promise;
+        std::optional<Result> value;
+        std::atomic<int> state{result_empty};
+        bool timeout = false;
+
+        // Attempts or replicas which actually ran
+        std::atomic<std::size_t> attempts{0};
+
+        bool published() const
+        {
+            return state.load(std::memory_order_acquire) == result_published;
+        }
+
+        // Returns true if res was stored, false if another result was
+        // claimed first
+        bool publish(Result&& res)
+        {
+            int expected = result_empty;
+            if (!state.compare_exchange_strong(
+                    expected, result_claimed, std::memory_order_relaxed))
+                return false;
+
+            value.emplace(std::move(res));
+            state.store(result_published, std::memory_order_release);
+            return true;
+        }
+
+        // Make the future ready with the published result, returns false if
+        // no valid result was published. Called once per task, either by
+        // the replica which published the result or after all of them have
+        // completed.
+        bool complete()
+        {
+            if (!published())
+                return false;
+
+            promise.set_value(std::move(*value));
+            return true;
+        }
+
+        // Report the error of the kernel, if any, or e otherwise
+        template <typename Exception>
+        void fail(hpx::shared_future<void>& f, Exception&& e)
+        {
+            if (f.has_exception())
+                promise.set_exception(f.get_exception_ptr());
+            else
+                promise.set_exception(
+                    std::make_exception_ptr(std::forward<Exception>(e)));
+        }
+
+        template <typename Exception>
+        void complete(hpx::shared_future<void>& f, Exception&& e)
+        {
+            if (!complete())
+                fail(f, std::forward<Exception>(e));
+        }
+    };
+
+    // Store a result at most once, following the protocol of
+    // host_result_slot. The first valid replica claims the state with a
+    // compare and swap, stores its result and only then marks it as
+    // published with a release store, so a published result is always
+    // complete. A claimed result already lets later replicas skip.
+    template <typename State, typename Store>
+    KOKKOS_INLINE_FUNCTION void publish_once(State* state, Store const& store)
+    {
+        if (Kokkos::atomic_compare_exchange(state, State(result_empty),
+                State(result_claimed)) != State(result_empty))
+            return;
+
+        store();
+
+        // The public Kokkos::atomic_store takes no memory order
+        Kokkos::Impl::atomic_store(state, State(result_published),
+            Kokkos::Impl::memory_order_release);
+    }
+
+    // Replicas skip once a result was claimed, they never read it
+    template <typename State>
+    KOKKOS_INLINE_FUNCTION bool result_taken(State* state)
+    {
+        return Kokkos::Impl::atomic_load(
+                   state, Kokkos::Impl::memory_order_relaxed) !=
+            State(result_empty);
+    }
+
+    // Result of a task replicated within a kernel on an execution space
+    // whose memory may not be accessible from the host. All replicas share
+    // a single result, stored with publish_once. The state of the result and
+    // the number of replicas which ran share one View, so a task allocates
+    // two Views whatever the number of replicas.
+    template <typename Result, typename ExecutionSpace>
+    struct device_result_slot
+    {
+        Kokkos::View<Result*, ExecutionSpace> result;
+
+        // State of the result, followed by the number of replicas which ran
+        Kokkos::View<std::size_t*, ExecutionSpace> status;
+
+        device_result_slot()
+          : result("device_result_slot_result", 1)
+          , status("device_result_slot_status", 2)
+        {
+        }
+
+        KOKKOS_INLINE_FUNCTION void count_replica() const
+        {
+            Kokkos::atomic_add(&status[1], std::size_t(1));
+        }
+
+        KOKKOS_INLINE_FUNCTION bool published() const
+        {
+            return result_taken(&status[0]);
+        }
+
+        KOKKOS_INLINE_FUNCTION void publish(Result&& res) const
+        {
+            publish_once(&status[0], [&] { result[0] = std::move(res); });
+        }
+
+        struct host_status
+        {
+            bool published;
+            std::size_t replicas;
+        };
+
+        // Called on the host once the kernel has completed. The state and
+        // the number of replicas which ran are copied in one transfer, the
+        // result is only copied by get if it was published.
+        host_status get_status() const
+        {
+            auto host_view = Kokkos::create_mirror_view(status);
+            Kokkos::deep_copy(host_view, status);
+
+            return {host_view[0] == std::size_t(result_published),
+                host_view[1]};
+        }
+
+        Result get() const
+        {
+            auto host_result = Kokkos::create_mirror_view(result);
+            Kokkos::deep_copy(host_result, result);
+
+            return std::move(host_result[0]);
+        }
+    };
+
+}}}}    // namespace hpx::kokkos::resiliency::detail
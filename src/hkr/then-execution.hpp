@@ -0,0 +1,315 @@
+#pragma once
+
+#include <hpx/functional/invoke.hpp>
+#include <hpx/future.hpp>
+#include <hpx/tuple.hpp>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
+
+    template <typename Future>
+    using predecessor_value_t = typename hpx::traits::future_traits<
+        typename std::decay<Future>::type>::type;
+
+    template <typename Future>
+    using predecessor_t = hpx::shared_future<predecessor_value_t<Future>>;
+
+    // Kernels copy their arguments, so the ready predecessor is carried into
+    // them as a shared_future. Work items are handed a future of the type
+    // the caller passed, as the executor contract requires.
+    template <typename Future>
+    struct rebuild_future;
+
+    template <typename T>
+    struct rebuild_future<hpx::shared_future<T>>
+    {
+        static hpx::shared_future<T> call(hpx::shared_future<T> const& pred)
+        {
+            return pred;
+        }
+    };
+
+    template <typename T>
+    struct rebuild_future<hpx::future<T>>
+    {
+        static hpx::future<T> call(hpx::shared_future<T> const& pred)
+        {
+            if (pred.has_exception())
+                return hpx::make_exceptional_future<T>(
+                    pred.get_exception_ptr());
+
+            if constexpr (std::is_void<T>::value)
+                return hpx::make_ready_future();
+            else
+                return hpx::make_ready_future(T(pred.get()));
+        }
+    };
+
+    // Invokes f with the predecessor followed by the remaining arguments
+    template <typename Future, typename F>
+    struct with_predecessor
+    {
+        F f;
+
+        template <typename Pred, typename... Ts>
+        decltype(auto) operator()(Pred const& pred, Ts&&... ts) const
+        {
+            return hpx::util::invoke(f, rebuild_future<Future>::call(pred),
+                std::forward<Ts>(ts)...);
+        }
+    };
+
+    // Same for bulk work items, which take the shape element first
+    template <typename Future, typename F>
+    struct bulk_with_predecessor
+    {
+        F f;
+
+        template <typename Elem, typename Pred, typename... Ts>
+        decltype(auto) operator()(
+            Elem&& elem, Pred const& pred, Ts&&... ts) const
+        {
+            return hpx::util::invoke(f, std::forward<Elem>(elem),
+                rebuild_future<Future>::call(pred), std::forward<Ts>(ts)...);
+        }
+    };
+
+    // Result of f invoked with the value of the predecessor, if any,
+    // followed by the remaining arguments
+    template <typename Value, typename F, typename... Ts>
+    struct unwrapped_then_result
+      : hpx::util::detail::invoke_deferred_result<F, Value const&, Ts...>
+    {
+    };
+
+    template <typename F, typename... Ts>
+    struct unwrapped_then_result<void, F, Ts...>
+      : hpx::util::detail::invoke_deferred_result<F, Ts...>
+    {
+    };
+
+    // Same for bulk work items
+    template <typename Value, typename F, typename Elem, typename... Ts>
+    struct unwrapped_bulk_then_result
+      : hpx::util::detail::invoke_deferred_result<F, Elem, Value const&,
+            Ts...>
+    {
+    };
+
+    template <typename F, typename Elem, typename... Ts>
+    struct unwrapped_bulk_then_result<void, F, Elem, Ts...>
+      : hpx::util::detail::invoke_deferred_result<F, Elem, Ts...>
+    {
+    };
+
+    // Invoke launch with the value of the ready predecessor, if any,
+    // followed by the packed arguments
+    template <typename Predecessor, typename Launch, typename Tuple>
+    decltype(auto) invoke_unwrapped(
+        Predecessor const& pred, Launch&& launch, Tuple& ts_pack)
+    {
+        return hpx::util::invoke_fused(
+            [&](auto&... ts) -> decltype(auto) {
+                if constexpr (std::is_void<
+                                  predecessor_value_t<Predecessor>>::value)
+                {
+                    // Rethrow the error of the predecessor, if any
+                    pred.get();
+                    return launch(ts...);
+                }
+                else
+                {
+                    return launch(pred.get(), ts...);
+                }
+            },
+            ts_pack);
+    }
+
+    // Invoke launch with the ready predecessor followed by the packed
+    // arguments
+    template <typename Predecessor, typename Launch, typename Tuple>
+    decltype(auto) invoke_wrapped(
+        Predecessor const& pred, Launch&& launch, Tuple& ts_pack)
+    {
+        return hpx::util::invoke_fused(
+            [&](auto&... ts) -> decltype(auto) { return launch(pred, ts...); },
+            ts_pack);
+    }
+
+    // Wait for all per element futures of a bulk launch without blocking
+    // and collect their values
+    template <typename Result>
+    decltype(auto) collect_bulk_results(
+        hpx::future<std::vector<hpx::shared_future<Result>>>&& results)
+    {
+        using bulk_result_t = std::vector<hpx::shared_future<Result>>;
+
+        return results.then(hpx::launch::sync,
+            [](hpx::future<bulk_result_t>&& f) {
+                auto futures = f.get();
+
+                if constexpr (std::is_void<Result>::value)
+                {
+                    for (auto& fut : futures)
+                        fut.get();
+                }
+                else
+                {
+                    std::vector<Result> values;
+                    values.reserve(futures.size());
+
+                    for (auto& fut : futures)
+                        values.push_back(fut.get());
+
+                    return values;
+                }
+            });
+    }
+
+    // Launch the resilient kernel from the completion of the predecessor.
+    // The work item is invoked with the predecessor future, followed by the
+    // remaining arguments.
+    template <typename Executor, typename F, typename Future, typename... Ts>
+    hpx::future<typename hpx::util::detail::invoke_deferred_result<F,
+        typename std::decay<Future>::type, Ts...>::type>
+    then_execute(Executor exec, F&& f, Future&& predecessor, Ts&&... ts)
+    {
+        using pred_t = predecessor_t<Future>;
+        using f_t = with_predecessor<typename std::decay<Future>::type,
+            typename std::decay<F>::type>;
+
+        return pred_t(std::forward<Future>(predecessor))
+            .then(hpx::launch::sync,
+                [exec = std::move(exec), f = f_t{std::forward<F>(f)},
+                    ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...)](
+                    pred_t&& pred) mutable {
+                    return invoke_wrapped(
+                        pred,
+                        [&](auto&&... args) {
+                            return exec.async_execute(
+                                f, std::forward<decltype(args)>(args)...);
+                        },
+                        ts_pack);
+                });
+    }
+
+    // Launch the fused bulk kernel from the completion of the predecessor.
+    // The per element results are collected once all of them are ready,
+    // without blocking any thread.
+    template <typename Executor, typename F, typename S, typename Future,
+        typename... Ts>
+    decltype(auto) bulk_then_execute(Executor exec, F&& f, S const& shape,
+        Future&& predecessor, Ts&&... ts)
+    {
+        using future_t = typename std::decay<Future>::type;
+        using pred_t = predecessor_t<Future>;
+        using result_t = typename hpx::util::detail::invoke_deferred_result<F,
+            decltype(*hpx::util::begin(shape)), future_t, Ts...>::type;
+        using bulk_result_t = std::vector<hpx::shared_future<result_t>>;
+        using f_t =
+            bulk_with_predecessor<future_t, typename std::decay<F>::type>;
+
+        hpx::future<bulk_result_t> results =
+            pred_t(std::forward<Future>(predecessor))
+                .then(hpx::launch::sync,
+                    [exec = std::move(exec), f = f_t{std::forward<F>(f)},
+                        shape,
+                        ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...)](
+                        pred_t&& pred) mutable {
+                        return hpx::when_all(invoke_wrapped(
+                            pred,
+                            [&](auto&&... args) {
+                                return exec.bulk_async_execute(f, shape,
+                                    std::forward<decltype(args)>(args)...);
+                            },
+                            ts_pack));
+                    });
+
+        return collect_bulk_results<result_t>(std::move(results));
+    }
+
+    // Variant of then_execute passing the value of the predecessor instead
+    // of the future, which can't be used within device kernels
+    template <typename Executor, typename F, typename Future, typename... Ts>
+    hpx::future<typename unwrapped_then_result<predecessor_value_t<Future>,
+        F, Ts...>::type>
+    then_execute_unwrapped(
+        Executor exec, F&& f, Future&& predecessor, Ts&&... ts)
+    {
+        using pred_t = predecessor_t<Future>;
+
+        return pred_t(std::forward<Future>(predecessor))
+            .then(hpx::launch::sync,
+                [exec = std::move(exec), f = std::forward<F>(f),
+                    ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...)](
+                    pred_t&& pred) mutable {
+                    return invoke_unwrapped(
+                        pred,
+                        [&](auto&&... args) {
+                            return exec.async_execute(
+                                f, std::forward<decltype(args)>(args)...);
+                        },
+                        ts_pack);
+                });
+    }
+
+    template <typename Executor, typename F, typename S, typename Future,
+        typename... Ts>
+    decltype(auto) bulk_then_execute_unwrapped(Executor exec, F&& f,
+        S const& shape, Future&& predecessor, Ts&&... ts)
+    {
+        using pred_t = predecessor_t<Future>;
+        using result_t =
+            typename unwrapped_bulk_then_result<predecessor_value_t<Future>,
+                F, decltype(*hpx::util::begin(shape)), Ts...>::type;
+        using bulk_result_t = std::vector<hpx::shared_future<result_t>>;
+
+        hpx::future<bulk_result_t> results =
+            pred_t(std::forward<Future>(predecessor))
+                .then(hpx::launch::sync,
+                    [exec = std::move(exec), f = std::forward<F>(f), shape,
+                        ts_pack = hpx::make_tuple(std::forward<Ts>(ts)...)](
+                        pred_t&& pred) mutable {
+                        return hpx::when_all(invoke_unwrapped(
+                            pred,
+                            [&](auto&&... args) {
+                                return exec.bulk_async_execute(f, shape,
+                                    std::forward<decltype(args)>(args)...);
+                            },
+                            ts_pack));
+                    });
+
+        return collect_bulk_results<result_t>(std::move(results));
+    }
+
+}}}}    // namespace hpx::kokkos::resiliency::detail
+
+namespace hpx { namespace kokkos { namespace resiliency {
+
+    // then_execute on a resilient executor invokes the work item with the
+    // predecessor future, as HPX requires. Kernels on device execution
+    // spaces can't take a future, these variants invoke the work item with
+    // the value of the predecessor instead, or without it for future<void>.
+    template <typename Executor, typename F, typename Future, typename... Ts>
+    decltype(auto) then_execute_unwrapped(
+        Executor&& exec, F&& f, Future&& predecessor, Ts&&... ts)
+    {
+        return detail::then_execute_unwrapped(std::forward<Executor>(exec),
+            std::forward<F>(f), std::forward<Future>(predecessor),
+            std::forward<Ts>(ts)...);
+    }
+
+    template <typename Executor, typename F, typename S, typename Future,
+        typename... Ts>
+    decltype(auto) bulk_then_execute_unwrapped(Executor&& exec, F&& f,
+        S const& shape, Future&& predecessor, Ts&&... ts)
+    {
+        return detail::bulk_then_execute_unwrapped(
+            std::forward<Executor>(exec), std::forward<F>(f), shape,
+            std::forward<Future>(predecessor), std::forward<Ts>(ts)...);
+    }
+
+}}}    // namespace hpx::kokkos::resiliency
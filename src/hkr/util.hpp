@@ -1,8 +1,14 @@
 #pragma once
 
+#include <Kokkos_Core.hpp>
+
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <exception>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
 
@@ -26,6 +32,101 @@ namespace hpx { namespace kokkos { namespace resiliency { namespace detail {
         }
     };
 
+    // Reported when replay stops because its time budget has been spent
+    struct resiliency_timeout_exception : public resiliency_exception
+    {
+        resiliency_timeout_exception()
+          : resiliency_exception("Resiliency time budget exceeded.")
+        {
+        }
+
+        resiliency_timeout_exception(std::string&& s)
+          : resiliency_exception(std::move(s))
+        {
+        }
+    };
+
+    // Aggregated report of the elements of a bulk launch that failed
+    struct bulk_resiliency_exception : public resiliency_exception
+    {
+        std::vector<std::size_t> failed;
+
+        bulk_resiliency_exception(
+            std::string&& s, std::vector<std::size_t>&& failed_indices)
+          : resiliency_exception(std::move(s))
+          , failed(std::move(failed_indices))
+        {
+        }
+    };
+
+    // Chunk size requested by the execution parameters. Zero means that the
+    // parameters leave the choice to the executor.
+    template <typename Parameters, typename Executor, typename F>
+    auto requested_chunk_size(int, Parameters&& params, Executor&& exec,
+        F&& f, std::size_t cores, std::size_t count)
+        -> decltype(params.get_chunk_size(exec, f, cores, count))
+    {
+        return params.get_chunk_size(exec, f, cores, count);
+    }
+
+    template <typename Parameters, typename Executor, typename F>
+    std::size_t requested_chunk_size(
+        long, Parameters&&, Executor&&, F&&, std::size_t, std::size_t)
+    {
+        return 0;
+    }
+
+    // Chunk size of the bulk work of a resilient executor. Parameters which
+    // leave the choice to the executor spread the work over num_spread
+    // chunks per core, but no more than num_task chunks.
+    template <typename Parameters, typename Executor, typename F>
+    std::size_t resilient_chunk_size(Parameters&& params,
+        Executor const& exec, F&& f, std::size_t cores, std::size_t count,
+        std::size_t num_spread, std::size_t num_task)
+    {
+        std::size_t chunk_size =
+            requested_chunk_size(0, params, exec, f, cores, count);
+        if (chunk_size != 0)
+            return chunk_size;
+
+        std::size_t num_chunks = (std::max)(
+            std::size_t(1), (std::min)(num_task, cores * num_spread));
+
+        return (std::max)(
+            std::size_t(1), (count + num_chunks - 1) / num_chunks);
+    }
+
+    // Turn a time budget into an absolute deadline, saturating on overflow
+    inline std::chrono::steady_clock::time_point make_deadline(
+        std::chrono::steady_clock::duration budget)
+    {
+        auto const now = std::chrono::steady_clock::now();
+
+        if (budget >= std::chrono::steady_clock::time_point::max() - now)
+            return std::chrono::steady_clock::time_point::max();
+
+        return now + budget;
+    }
+
+    // Run a single replica and hand its result to publish. Replicas
+    // starting after a sibling has published a valid result are skipped, and
+    // so are results completing after that. Returns whether the replica ran.
+    template <typename Published, typename Invoke, typename Publish>
+    KOKKOS_INLINE_FUNCTION bool run_replica(Published const& published,
+        Invoke const& invoke, Publish const& publish)
+    {
+        if (published())
+            return false;
+
+        auto res = invoke();
+
+        // A sibling may have won while this replica was running
+        if (!published())
+            publish(std::move(res));
+
+        return true;
+    }
+
 }}}}    // namespace hpx::kokkos::resiliency::detail
 
 namespace Kokkos { namespace Impl { namespace traits {
@@ -5,6 +5,9 @@
 #include <hkr/hpx-kokkos-resiliency-executor.hpp>
 #include <hkr/hpx-kokkos-resiliency.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <random>
 
 int test_func(int random_arg)
@@ -12,6 +15,11 @@ int test_func(int random_arg)
     return 42;
 }
 
+int next_func(hpx::shared_future<int> f)
+{
+    return f.get();
+}
+
 bool validate(int unused_arg)
 {
     return true;
@@ -22,6 +30,15 @@ bool false_validate(int unused_arg)
     return false;
 }
 
+// Rejects the first num_rejected attempts
+std::size_t const num_rejected = 2;
+std::atomic<std::size_t> num_validations(0);
+
+bool late_validate(int unused_arg)
+{
+    return ++num_validations > num_rejected;
+}
+
 int main(int argc, char* argv[])
 {
     Kokkos::initialize(argc, argv);
@@ -39,6 +56,21 @@ int main(int argc, char* argv[])
                 exec_, 3, validate, test_func, random_arg);
         std::cout << "Returned value from direct API:" << f1.get() << std::endl;
 
+        // Every attempt runs as a separate task
+        hpx::shared_future<int> f6 =
+            hpx::kokkos::resiliency::async_replay_validate_split(
+                exec_, 3, late_validate, test_func, random_arg);
+        std::cout << "Returned value from split replay:" << f6.get()
+                  << std::endl;
+
+        if (num_validations != num_rejected + 1)
+        {
+            std::cout << "Split replay validated " << num_validations
+                      << " attempts instead of " << num_rejected + 1
+                      << std::endl;
+            return 1;
+        }
+
         // Using async with replay executors
         auto exec =
             hpx::kokkos::resiliency::make_replay_executor(exec_, 3, validate);
@@ -46,6 +78,17 @@ int main(int argc, char* argv[])
         std::cout << "Returned value from replay executor:" << f2.get()
                   << std::endl;
 
+        // Replaying inline on the calling thread
+        int v = hpx::parallel::execution::sync_execute(
+            exec, test_func, random_arg);
+        std::cout << "Returned value from sync execution:" << v << std::endl;
+
+        // Chaining resilient tasks
+        hpx::future<int> f5 = hpx::parallel::execution::then_execute(
+            exec, next_func, hpx::async(exec, test_func, random_arg));
+        std::cout << "Returned value from continuation:" << f5.get()
+                  << std::endl;
+
         // Catching exceptions
         try
         {
@@ -61,6 +104,22 @@ int main(int argc, char* argv[])
             std::cout << e.what() << std::endl;
         }
 
+        // Bounding replay by a time budget
+        try
+        {
+            hpx::shared_future<int> f4 =
+                hpx::kokkos::resiliency::async_replay_validate_for(exec_,
+                    std::chrono::milliseconds(10), 1000000, false_validate,
+                    test_func, random_arg);
+
+            std::cout << "Trying to return value: " << f4.get() << std::endl;
+        }
+        catch (hpx::kokkos::resiliency::detail::resiliency_timeout_exception&
+                e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
         std::cout << "Program ran correctly!" << std::endl;
     }
 
@@ -0,0 +1,90 @@
+#include <hpx/kokkos.hpp>
+
+#include <hpx/kokkos/detail/polling_helper.hpp>
+#include <hkr/executor/returning-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency.hpp>
+
+#include <random>
+
+struct test_func
+{
+    HPX_HOST_DEVICE int operator()(std::size_t i, int random_arg) const
+    {
+        return i % 2 == 0 ? 42 : 41;
+    }
+};
+
+struct validate
+{
+    HPX_HOST_DEVICE bool operator()(int result) const
+    {
+        return result == 42;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    Kokkos::initialize(argc, argv);
+
+    {
+        hpx::kokkos::detail::polling_helper helper;
+
+        hpx::kokkos::returning_executor exec_;
+        hpx::kokkos::returning_host_executor host_exec_;
+
+        int random_arg = std::rand();
+
+        // Replay 100 tasks within a single kernel on the device
+        auto f1 = hpx::kokkos::resiliency::async_replay_validate_n(
+            exec_, 100, 3, validate{}, test_func{}, random_arg);
+
+        // Replay 100 tasks within a single kernel on the host
+        auto f2 = hpx::kokkos::resiliency::async_replay_validate_n(
+            host_exec_, 100, 3, validate{}, test_func{}, random_arg);
+
+        auto device_result = f1.get();
+        auto host_result = f2.get();
+
+        auto device_failed = hpx::get<1>(device_result);
+        auto host_failed = hpx::get<1>(host_result);
+
+        std::size_t num_failed = 0;
+        for (std::size_t i = 0; i != 100; ++i)
+        {
+            if (device_failed[i] != host_failed[i])
+            {
+                std::cout << "Mismatch in failure mask at index " << i
+                          << std::endl;
+                return 1;
+            }
+
+            // Odd indices never produce a valid result
+            if (host_failed[i] != (i % 2 == 1))
+            {
+                std::cout << "Unexpected failure mask at index " << i
+                          << std::endl;
+                return 1;
+            }
+
+            if (host_failed[i])
+                ++num_failed;
+        }
+
+        std::cout << "Number of failed tasks: " << num_failed << std::endl;
+        if (num_failed != 50)
+        {
+            std::cout << "Expected 50 failed tasks" << std::endl;
+            return 1;
+        }
+
+        std::cout << "Returned value from index 0: "
+                  << hpx::get<0>(host_result)[0] << std::endl;
+
+        std::cout << "Program ran correctly!" << std::endl;
+    }
+
+    Kokkos::finalize();
+
+    return 0;
+}
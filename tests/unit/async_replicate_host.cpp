@@ -5,6 +5,8 @@
 #include <hkr/hpx-kokkos-resiliency-executor.hpp>
 #include <hkr/hpx-kokkos-resiliency.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <random>
 
 int test_func(int random_arg)
@@ -22,6 +24,29 @@ bool false_validate(int unused_arg)
     return false;
 }
 
+std::unique_ptr<int> make_result(int random_arg)
+{
+    return std::make_unique<int>(42);
+}
+
+bool validate_result(std::unique_ptr<int> const& result)
+{
+    return result != nullptr;
+}
+
+int sum_func(Kokkos::View<const int*, Kokkos::HostSpace> input)
+{
+    int sum = 0;
+    for (std::size_t i = 0; i != input.extent(0); ++i)
+        sum += input(i);
+    return sum;
+}
+
+bool validate_sum(int sum)
+{
+    return sum == 42;
+}
+
 int main(int argc, char* argv[])
 {
     Kokkos::initialize(argc, argv);
@@ -39,6 +64,25 @@ int main(int argc, char* argv[])
                 exec_, 3, validate, test_func, random_arg);
         std::cout << "Returned value from direct API:" << f1.get() << std::endl;
 
+        // Move-only results are moved out of the future
+        std::unique_ptr<int> p =
+            hpx::kokkos::resiliency::async_replicate_validate(
+                exec_, 3, validate_result, make_result, random_arg)
+                .get();
+        std::cout << "Returned move-only value from direct API:" << *p
+                  << std::endl;
+
+        // Replicas spread over the NUMA domains, each reading its own copy
+        // of the input
+        Kokkos::View<int*, Kokkos::HostSpace> input("input", 6);
+        Kokkos::deep_copy(input, 7);
+        hpx::future<int> sum_f =
+            hpx::kokkos::resiliency::async_replicate_validate_placed(exec_,
+                hpx::kokkos::resiliency::numa_placement{}, 3, validate_sum,
+                sum_func, Kokkos::View<const int*, Kokkos::HostSpace>(input));
+        std::cout << "Returned value from placed replicas:" << sum_f.get()
+                  << std::endl;
+
         // Using async with replay executors
         auto exec = hpx::kokkos::resiliency::make_replicate_executor(
             exec_, 3, validate);
@@ -46,6 +90,35 @@ int main(int argc, char* argv[])
         std::cout << "Returned value from replicate executor:" << f2.get()
                   << std::endl;
 
+        // Hedged replication learns its threshold from earlier tasks
+        auto hedged_exec =
+            hpx::kokkos::resiliency::make_hedged_replicate_executor(
+                exec_, 3, validate, 0.9);
+        for (int i = 0; i != 10; ++i)
+            hpx::async(hedged_exec, test_func, random_arg).get();
+        hpx::shared_future<int> f4 =
+            hpx::async(hedged_exec, test_func, random_arg);
+        std::cout << "Returned value from hedged replicate executor:"
+                  << f4.get() << std::endl;
+
+        // Adaptive execution picks a strategy per task
+        auto adaptive_exec = hpx::kokkos::resiliency::make_adaptive_executor(
+            exec_, 3, validate);
+        for (int i = 0; i != 10; ++i)
+            hpx::async(adaptive_exec, test_func, random_arg).get();
+        std::cout << "Returned value from adaptive executor:"
+                  << hpx::async(adaptive_exec, test_func, random_arg).get()
+                  << std::endl;
+
+        // Copies share the base executor and the collected statistics
+        auto hedged_copy = hedged_exec;
+        auto adaptive_copy = adaptive_exec;
+        if (hedged_copy != hedged_exec || adaptive_copy != adaptive_exec)
+        {
+            std::cout << "Executor copies compare unequal" << std::endl;
+            return 1;
+        }
+
         // Catching exceptions
         try
         {
@@ -61,6 +134,21 @@ int main(int argc, char* argv[])
             std::cout << e.what() << std::endl;
         }
 
+        try
+        {
+            auto except_exec =
+                hpx::kokkos::resiliency::make_hedged_replicate_executor(
+                    exec_, 3, false_validate);
+            hpx::shared_future<int> f5 =
+                hpx::async(except_exec, test_func, random_arg);
+
+            std::cout << "Trying to return value: " << f5.get() << std::endl;
+        }
+        catch (hpx::kokkos::resiliency::detail::resiliency_exception& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
         std::cout << "Program ran correctly!" << std::endl;
     }
 
@@ -5,13 +5,37 @@
 #include <hkr/hpx-kokkos-resiliency-executor.hpp>
 #include <hkr/hpx-kokkos-resiliency.hpp>
 
+#include <atomic>
+#include <numeric>
 #include <random>
+#include <stdexcept>
+#include <vector>
 
 int test_func(int random_arg)
 {
     return 42;
 }
 
+std::atomic<int> transient_failures(1);
+
+// Fails once, the retry succeeds
+int transient_func(int i)
+{
+    if (transient_failures-- > 0)
+        throw std::runtime_error("Transient error");
+
+    return 42;
+}
+
+// Fails every time it is called for iteration 42
+int failing_func(int i)
+{
+    if (i == 42)
+        throw std::runtime_error("Permanent error");
+
+    return 42;
+}
+
 bool validate(int unused_arg)
 {
     return true;
@@ -19,7 +43,6 @@ bool validate(int unused_arg)
 
 bool false_validate(int unused_arg)
 {
-    std::cout << "here" << std::endl;
     return false;
 }
 
@@ -33,23 +56,96 @@ int main(int argc, char* argv[])
         hpx::kokkos::returning_executor exec_;
         hpx::kokkos::returning_host_executor host_exec_;
 
-        // Bulk aync facility
-        auto exec =
+        // Work items without a result run once per element on the default
+        // execution space
+        auto device_exec =
             hpx::kokkos::resiliency::make_replay_executor(exec_, 3, validate);
+        hpx::for_loop(hpx::execution::par.on(device_exec), 0, 100, test_func);
+
+        auto device_replicate_exec =
+            hpx::kokkos::resiliency::make_replicate_executor(
+                exec_, 3, validate);
+        hpx::for_loop(
+            hpx::execution::par.on(device_replicate_exec), 0, 100, test_func);
+
+        // Bulk aync facility. The chunks of a for_loop have no result, they
+        // are replayed until they complete without throwing.
+        auto exec = hpx::kokkos::resiliency::make_replay_executor(
+            host_exec_, 3, validate);
         hpx::for_loop(hpx::execution::par.on(exec), 0, 100, test_func);
 
+        // Every chunk of 10 iterations is a single work item, the chunk
+        // hitting the transient error is replayed as a whole
+        hpx::for_loop(hpx::execution::par.on(exec).with(
+                          hpx::execution::static_chunk_size(10)),
+            0, 100, transient_func);
+
+        bool captured = false;
+        try
+        {
+            hpx::for_loop(hpx::execution::par.on(exec), 0, 100, failing_func);
+        }
+        catch (...)
+        {
+            captured = true;
+            std::cout << "Error captured!" << std::endl;
+        }
+
+        if (!captured)
+        {
+            std::cout << "Failing chunk was not reported" << std::endl;
+            return 1;
+        }
+
         auto host_exec = hpx::kokkos::resiliency::make_replay_executor(
             host_exec_, 3, false_validate);
 
+        // Per element replay of work items returning a result
+        std::vector<int> shape(100);
+        std::iota(shape.begin(), shape.end(), 0);
+
+        auto futures = hpx::parallel::execution::bulk_async_execute(
+            host_exec, test_func, shape);
+        hpx::wait_all(futures);
+
         try
         {
-            hpx::for_loop(hpx::execution::par.on(host_exec), 0, 100, test_func);
+            futures[0].get();
+        }
+        catch (hpx::kokkos::resiliency::detail::bulk_resiliency_exception& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
+        // Replicated bulk execution in a single kernel
+        auto replicate_exec = hpx::kokkos::resiliency::make_replicate_executor(
+            host_exec_, 3, validate);
+        hpx::for_loop(
+            hpx::execution::par.on(replicate_exec), 0, 100, test_func);
+
+        captured = false;
+        try
+        {
+            hpx::for_loop(
+                hpx::execution::par.on(replicate_exec), 0, 100, failing_func);
         }
         catch (...)
         {
+            captured = true;
             std::cout << "Error captured!" << std::endl;
         }
 
+        if (!captured)
+        {
+            std::cout << "Failing chunk was not reported" << std::endl;
+            return 1;
+        }
+
+        auto replicate_futures = hpx::parallel::execution::bulk_async_execute(
+            replicate_exec, test_func, shape);
+        std::cout << "Returned value from replicate executor: "
+                  << replicate_futures[0].get() << std::endl;
+
         std::cout << "Program ran correctly!" << std::endl;
     }
 
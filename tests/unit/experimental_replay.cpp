@@ -2,7 +2,11 @@
 #include <hkr/kokkos-executor.hpp>
 #include <hkr/util.hpp>
 
+#include <chrono>
+#include <numeric>
 #include <random>
+#include <utility>
+#include <vector>
 
 struct test_function
 {
@@ -12,6 +16,22 @@ struct test_function
     }
 };
 
+struct next_function
+{
+    int operator()(hpx::future<int> f) const
+    {
+        return f.get();
+    }
+};
+
+struct next_value_function
+{
+    HPX_HOST_DEVICE int operator()(int value) const
+    {
+        return value;
+    }
+};
+
 struct validate
 {
     HPX_HOST_DEVICE constexpr bool operator()(int unused_arg) const
@@ -53,6 +73,54 @@ int main(int argc, char* argv[])
         std::cout << "Returned value from replay executor:" << device_f.get()
                   << std::endl;
 
+        // Chaining resilient kernels
+        hpx::future<int> first_f =
+            hpx::async(exec, test_function{}, random_arg);
+        hpx::future<int> next_f = hpx::parallel::execution::then_execute(
+            exec, next_function{}, std::move(first_f));
+        std::cout << "Returned value from continuation:" << next_f.get()
+                  << std::endl;
+
+        // Every stage of a pipeline on a pinned copy runs on one instance
+        {
+            auto pinned_exec = exec.pin();
+            hpx::future<int> stage_f =
+                hpx::async(pinned_exec, test_function{}, random_arg);
+            for (int i = 0; i != 3; ++i)
+                stage_f = hpx::parallel::execution::then_execute(
+                    pinned_exec, next_function{}, std::move(stage_f));
+            std::cout << "Returned value from pinned pipeline:"
+                      << stage_f.get() << std::endl;
+        }
+
+        // Device kernels can't take a future, they get its value instead
+        auto device_exec =
+            hpx::kokkos::experimental::resiliency::make_replay_executor(
+                device_inst, 3, validate{});
+        hpx::future<int> next_value_f =
+            hpx::kokkos::resiliency::then_execute_unwrapped(device_exec,
+                next_value_function{},
+                hpx::async(device_exec, test_function{}, random_arg));
+        std::cout << "Returned value from unwrapped continuation:"
+                  << next_value_f.get() << std::endl;
+
+        // Keeping two attempts in flight at once
+        auto speculative_exec = hpx::kokkos::experimental::resiliency::
+            make_speculative_replay_executor(host_inst, 3, validate{}, 2);
+        hpx::future<int> speculative_f =
+            hpx::async(speculative_exec, test_function{}, random_arg);
+        std::cout << "Returned value from speculative replay executor:"
+                  << speculative_f.get() << std::endl;
+
+        // Per element replay of the whole shape within one kernel
+        std::vector<int> shape(100);
+        std::iota(shape.begin(), shape.end(), 0);
+
+        auto futures = hpx::parallel::execution::bulk_async_execute(
+            exec, test_function{}, shape);
+        std::cout << "Returned value from bulk replay:" << futures[0].get()
+                  << std::endl;
+
         // Catching exceptions
         try
         {
@@ -70,6 +138,45 @@ int main(int argc, char* argv[])
             std::cout << e.what() << std::endl;
         }
 
+        // Bounding replay by a time budget
+        try
+        {
+            auto timed_exec =
+                hpx::kokkos::experimental::resiliency::make_replay_executor(
+                    host_inst, 1000000, false_validate{},
+                    std::chrono::milliseconds(10));
+            hpx::future<int> timed_f =
+                hpx::async(timed_exec, test_function{}, random_arg);
+
+            std::cout << "Trying to return value: " << timed_f.get()
+                      << std::endl;
+        }
+        catch (hpx::kokkos::resiliency::detail::resiliency_timeout_exception&
+                e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
+        // The budget is honored on the device as well
+        try
+        {
+            auto timed_exec =
+                hpx::kokkos::experimental::resiliency::make_replay_executor(
+                    device_inst, 1000000, false_validate{},
+                    std::chrono::milliseconds(10));
+            hpx::future<int> timed_f =
+                hpx::async(timed_exec, test_function{}, random_arg);
+
+            std::cout << "Trying to return value: " << timed_f.get()
+                      << std::endl;
+            return 1;
+        }
+        catch (hpx::kokkos::resiliency::detail::resiliency_timeout_exception&
+                e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
         std::cout << "Program ran correctly!" << std::endl;
     }
 
@@ -2,7 +2,11 @@
 #include <hkr/kokkos-executor.hpp>
 #include <hkr/util.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <numeric>
 #include <random>
+#include <vector>
 
 struct test_function
 {
@@ -12,6 +16,17 @@ struct test_function
     }
 };
 
+std::atomic<std::size_t> num_calls(0);
+
+struct counting_function
+{
+    int operator()(int random_arg) const
+    {
+        ++num_calls;
+        return 42;
+    }
+};
+
 struct validate
 {
     HPX_HOST_DEVICE constexpr bool operator()(int unused_arg) const
@@ -54,6 +69,48 @@ int main(int argc, char* argv[])
         std::cout << "Returned value from replicate executor:" << device_f.get()
                   << std::endl;
 
+        // Per element replicate of the whole shape within one kernel
+        std::vector<int> shape(100);
+        std::iota(shape.begin(), shape.end(), 0);
+
+        auto futures = hpx::parallel::execution::bulk_async_execute(
+            exec, test_function{}, shape);
+        std::cout << "Returned value from bulk replicate:" << futures[0].get()
+                  << std::endl;
+
+        // Replicas starting after the first valid result are skipped, so at
+        // most one replica per worker runs
+        auto skip_exec =
+            hpx::kokkos::experimental::resiliency::make_replicate_executor(
+                host_inst, 100, validate{});
+        hpx::async(skip_exec, counting_function{}, random_arg).get();
+        std::cout << "Number of replicas run:" << num_calls << std::endl;
+        if (num_calls > hpx::get_os_thread_count())
+        {
+            std::cout << "Replicas were not skipped" << std::endl;
+            return 1;
+        }
+
+        // Spreading replicas over the NUMA domains
+        auto numa_exec =
+            hpx::kokkos::experimental::resiliency::make_replicate_executor(
+                host_inst, 3, validate{},
+                hpx::kokkos::resiliency::numa_placement{});
+        hpx::future<int> numa_f =
+            hpx::async(numa_exec, test_function{}, random_arg);
+        std::cout << "Returned value from NUMA placed replicas:"
+                  << numa_f.get() << std::endl;
+
+        // Running replicas on named thread pools
+        auto pool_exec =
+            hpx::kokkos::experimental::resiliency::make_replicate_executor(
+                host_inst, 3, validate{},
+                hpx::kokkos::resiliency::pool_placement({"default"}));
+        hpx::future<int> pool_f =
+            hpx::async(pool_exec, test_function{}, random_arg);
+        std::cout << "Returned value from pool placed replicas:"
+                  << pool_f.get() << std::endl;
+
         // Catching exceptions
         try
         {
@@ -0,0 +1,107 @@
+#include <hpx/kokkos.hpp>
+
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/kokkos/detail/polling_helper.hpp>
+#include <hkr/executor/returning-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency.hpp>
+#include <hkr/performance-counters.hpp>
+#include <hkr/replay-execution-space.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+
+std::atomic<int> num_calls(0);
+
+int test_func(int random_arg)
+{
+    return 42;
+}
+
+// Pass validation every third attempt
+bool validate(int unused_arg)
+{
+    return ++num_calls % 3 == 0;
+}
+
+struct false_validator
+{
+    KOKKOS_FUNCTION bool operator()(int, int) const
+    {
+        return false;
+    }
+};
+
+struct operation
+{
+    KOKKOS_FUNCTION int operator()(int) const
+    {
+        return 42;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    Kokkos::initialize(argc, argv);
+
+    {
+        hpx::kokkos::detail::polling_helper helper;
+
+        hpx::kokkos::resiliency::register_counter_types();
+
+        hpx::kokkos::returning_host_executor exec_;
+
+        int random_arg = std::rand();
+
+        auto exec =
+            hpx::kokkos::resiliency::make_replay_executor(exec_, 3, validate);
+        for (int i = 0; i != 10; ++i)
+            hpx::async(exec, test_func, random_arg).get();
+
+        hpx::performance_counters::performance_counter replays(
+            "/resiliency-kokkos{locality#0/total}/replays");
+        hpx::performance_counters::performance_counter attempts(
+            "/resiliency-kokkos{locality#0/total}/attempts-per-task");
+
+        std::cout << "Replays: " << replays.get_value<std::int64_t>().get()
+                  << std::endl;
+        std::cout << "Attempts per task (x1000): "
+                  << attempts.get_value<std::int64_t>().get() << std::endl;
+
+        // Resilient execution spaces are counted as well
+        hpx::performance_counters::performance_counter failures(
+            "/resiliency-kokkos{locality#0/total}/failures");
+        std::int64_t failures_before =
+            failures.get_value<std::int64_t>().get();
+
+        Kokkos::Experimental::HPX inst{};
+        Kokkos::ResilientReplay<Kokkos::Experimental::HPX, false_validator>
+            replay_inst(3, false_validator{}, inst);
+
+        try
+        {
+            Kokkos::parallel_for(
+                Kokkos::RangePolicy<Kokkos::ResilientReplay<
+                    Kokkos::Experimental::HPX, false_validator>>(
+                    replay_inst, 0, 10),
+                operation{});
+        }
+        catch (std::runtime_error const& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
+        std::int64_t failures_after = failures.get_value<std::int64_t>().get();
+        std::cout << "Failures in execution space: "
+                  << failures_after - failures_before << std::endl;
+        if (failures_after - failures_before != 10)
+            return 1;
+
+        std::cout << "Program ran correctly!" << std::endl;
+    }
+
+    Kokkos::finalize();
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/resource_partitioner.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/modules/errors.hpp>
+
+#include <hpx/kokkos/detail/polling_helper.hpp>
+#include <hkr/kokkos-executor.hpp>
+#include <hkr/placement.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+std::vector<std::string> replica_pools;
+bool oversubscription_rejected = false;
+
+struct pool_function
+{
+    // Returns 42 if the replica runs on the replica pool
+    int operator()(int random_arg) const
+    {
+        return hpx::this_thread::get_pool()->get_pool_name() ==
+                replica_pools[0] ?
+            42 :
+            0;
+    }
+};
+
+struct validate
+{
+    constexpr bool operator()(int value) const
+    {
+        return value == 42;
+    }
+};
+
+void create_pools(hpx::resource::partitioner& rp,
+    hpx::program_options::variables_map const&)
+{
+    // The default pool has to keep a core
+    try
+    {
+        hpx::kokkos::resiliency::create_replica_pools(
+            rp, hpx::threads::hardware_concurrency());
+    }
+    catch (hpx::exception const& e)
+    {
+        oversubscription_rejected = e.get_error() == hpx::bad_parameter;
+    }
+
+    try
+    {
+        replica_pools = hpx::kokkos::resiliency::create_replica_pools(rp, 1);
+    }
+    catch (hpx::exception const&)
+    {
+        // A single core can't be split into pools
+    }
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    Kokkos::initialize(argc, argv);
+
+    int result = 0;
+
+    {
+        hpx::kokkos::detail::polling_helper helper;
+
+        int random_arg = std::rand();
+
+        if (!oversubscription_rejected)
+        {
+            std::cout << "Pools using every core were accepted" << std::endl;
+            result = 1;
+        }
+        else if (replica_pools.empty())
+        {
+            std::cout << "Not enough cores to create a replica pool"
+                      << std::endl;
+        }
+        else
+        {
+            Kokkos::Experimental::HPX host_inst{};
+
+            // Every replica runs on the single replica pool
+            auto pool_exec =
+                hpx::kokkos::experimental::resiliency::make_replicate_executor(
+                    host_inst, 3, validate{},
+                    hpx::kokkos::resiliency::pool_placement(replica_pools));
+            int value =
+                hpx::async(pool_exec, pool_function{}, random_arg).get();
+            std::cout << "Returned value from pool placed replicas:" << value
+                      << std::endl;
+
+            if (value != 42)
+            {
+                std::cout << "Replicas did not run on " << replica_pools[0]
+                          << std::endl;
+                result = 1;
+            }
+        }
+
+        if (result == 0)
+            std::cout << "Program ran correctly!" << std::endl;
+    }
+
+    Kokkos::finalize();
+
+    hpx::finalize();
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    hpx::init_params init_args;
+    init_args.rp_callback = &create_pools;
+
+    return hpx::init(argc, argv, init_args);
+}
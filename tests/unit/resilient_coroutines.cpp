@@ -0,0 +1,65 @@
+#include <hpx/kokkos.hpp>
+
+#include <hpx/kokkos/detail/polling_helper.hpp>
+#include <hkr/executor/returning-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency-coroutines.hpp>
+
+#include <random>
+
+struct test_func
+{
+    HPX_HOST_DEVICE int operator()(int random_arg) const
+    {
+        return 42;
+    }
+};
+
+struct validate
+{
+    HPX_HOST_DEVICE bool operator()(int result) const
+    {
+        return result == 42;
+    }
+};
+
+#if defined(HPX_HAVE_CXX20_COROUTINES)
+hpx::future<int> resilient_task(hpx::kokkos::returning_host_executor& exec,
+    hpx::kokkos::returning_executor& device_exec, int random_arg)
+{
+    // Suspend instead of blocking on the resilient tasks
+    int a = co_await hpx::kokkos::resiliency::replay_validate_awaitable(
+        exec, 3, validate{}, test_func{}, random_arg);
+    int b = co_await hpx::kokkos::resiliency::replicate_validate_awaitable(
+        device_exec, 3, validate{}, test_func{}, random_arg);
+
+    co_return a + b;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+    Kokkos::initialize(argc, argv);
+
+    {
+        hpx::kokkos::detail::polling_helper helper;
+
+        hpx::kokkos::returning_executor exec_;
+        hpx::kokkos::returning_host_executor host_exec_;
+
+        int random_arg = std::rand();
+
+#if defined(HPX_HAVE_CXX20_COROUTINES)
+        hpx::future<int> f = resilient_task(host_exec_, exec_, random_arg);
+        std::cout << "Returned value from coroutine: " << f.get()
+                  << std::endl;
+#else
+        std::cout << "HPX was built without coroutine support" << std::endl;
+#endif
+
+        std::cout << "Program ran correctly!" << std::endl;
+    }
+
+    Kokkos::finalize();
+
+    return 0;
+}
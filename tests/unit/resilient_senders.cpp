@@ -0,0 +1,80 @@
+#include <hpx/kokkos.hpp>
+
+#include <hpx/kokkos/detail/polling_helper.hpp>
+#include <hkr/executor/returning-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency-senders.hpp>
+
+#include <hpx/execution.hpp>
+
+#include <random>
+
+struct test_func
+{
+    HPX_HOST_DEVICE int operator()(int random_arg) const
+    {
+        return 42;
+    }
+};
+
+struct validate
+{
+    HPX_HOST_DEVICE bool operator()(int result) const
+    {
+        return result == 42;
+    }
+};
+
+struct false_validate
+{
+    HPX_HOST_DEVICE bool operator()(int unused_arg) const
+    {
+        return false;
+    }
+};
+
+int main(int argc, char* argv[])
+{
+    Kokkos::initialize(argc, argv);
+
+    {
+        namespace ex = hpx::execution::experimental;
+
+        hpx::kokkos::detail::polling_helper helper;
+
+        hpx::kokkos::returning_executor exec_;
+        hpx::kokkos::returning_host_executor host_exec_;
+
+        int random_arg = std::rand();
+
+        // Compose replayed and replicated tasks without futures
+        auto replay = hpx::kokkos::resiliency::replay_validate_sender(
+            exec_, 3, validate{}, test_func{}, random_arg);
+        auto replicate = hpx::kokkos::resiliency::replicate_validate_sender(
+            host_exec_, 3, validate{}, test_func{}, random_arg);
+
+        auto sum = ex::sync_wait(ex::then(
+            ex::when_all(std::move(replay), std::move(replicate)),
+            [](int a, int b) { return a + b; }));
+        std::cout << "Returned value from senders: " << sum << std::endl;
+
+        // Catching exceptions
+        try
+        {
+            auto except = hpx::kokkos::resiliency::replay_validate_sender(
+                host_exec_, 3, false_validate{}, test_func{}, random_arg);
+
+            std::cout << "Trying to return value: "
+                      << ex::sync_wait(std::move(except)) << std::endl;
+        }
+        catch (hpx::kokkos::resiliency::detail::resiliency_exception& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
+        std::cout << "Program ran correctly!" << std::endl;
+    }
+
+    Kokkos::finalize();
+
+    return 0;
+}
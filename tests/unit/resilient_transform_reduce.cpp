@@ -0,0 +1,77 @@
+#include <hpx/kokkos.hpp>
+
+#include <hpx/kokkos/detail/polling_helper.hpp>
+#include <hkr/executor/returning-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency-algorithms.hpp>
+#include <hkr/hpx-kokkos-resiliency-executor.hpp>
+#include <hkr/hpx-kokkos-resiliency.hpp>
+
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+std::atomic<int> num_calls(0);
+
+// Reject the first partial result seen, forcing one chunk to be replayed
+bool validate(int unused_arg)
+{
+    return num_calls++ != 0;
+}
+
+bool false_validate(int unused_arg)
+{
+    return false;
+}
+
+int square(int i)
+{
+    return i * i;
+}
+
+int main(int argc, char* argv[])
+{
+    Kokkos::initialize(argc, argv);
+
+    {
+        hpx::kokkos::detail::polling_helper helper;
+
+        hpx::kokkos::returning_host_executor exec_;
+
+        std::vector<int> values(1000);
+        std::iota(values.begin(), values.end(), 0);
+
+        auto exec =
+            hpx::kokkos::resiliency::make_replay_executor(exec_, 3, validate);
+        int sum = hpx::transform_reduce(hpx::execution::par.on(exec),
+            values.begin(), values.end(), 0, std::plus<int>(), square);
+        std::cout << "Returned value from replay executor: " << sum
+                  << std::endl;
+
+        auto replicate_exec = hpx::kokkos::resiliency::make_replicate_executor(
+            exec_, 3, validate);
+        hpx::future<int> f = hpx::transform_reduce(
+            hpx::execution::par(hpx::execution::task).on(replicate_exec),
+            values.begin(), values.end(), 0, std::plus<int>(), square);
+        std::cout << "Returned value from replicate executor: " << f.get()
+                  << std::endl;
+
+        try
+        {
+            auto except_exec = hpx::kokkos::resiliency::make_replay_executor(
+                exec_, 3, false_validate);
+            hpx::transform_reduce(hpx::execution::par.on(except_exec),
+                values.begin(), values.end(), 0, std::plus<int>(), square);
+        }
+        catch (hpx::kokkos::resiliency::detail::bulk_resiliency_exception& e)
+        {
+            std::cout << e.what() << std::endl;
+        }
+
+        std::cout << "Program ran correctly!" << std::endl;
+    }
+
+    Kokkos::finalize();
+
+    return 0;
+}